@@ -5,6 +5,11 @@
 #include <stdlib.h>
 #include <memory.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #define COMPONENTE_NAO_DEFINIDO 0
 
@@ -24,33 +29,149 @@ typedef struct vert
     Aresta *prim;
 } Vertice;
 
+/*
+Bloco de memoria de onde sao retiradas as celulas de aresta.
+Em vez de um malloc por aresta, as celulas sao reservadas em 
+blocos grandes, liberados todos de uma vez junto com o grafo
+*/
+#define ARESTAS_POR_BLOCO 4096
+
+typedef struct blocoArestas
+{
+    struct blocoArestas *prox; /* bloco reservado anteriormente */
+    int usadas;
+    Aresta celulas[ARESTAS_POR_BLOCO];
+} BlocoArestas;
+
+/*
+Dados do grafo como um todo, guardados na mesma alocacao do vetor
+de vertices, logo antes dele. Apenas vetores criados por criaGrafo
+possuem esses dados
+*/
+typedef struct dadosGrafo
+{
+    BlocoArestas *blocos; /* arena de arestas, com o bloco atual a frente */
+
+    /* Contagens mantidas a cada aresta acrescentada, sem percorrer as listas */
+    int *grau;      /* celulas na lista de cada vertice: um laco conta duas vezes */
+    int numArestas; /* arestas acrescentadas */
+
+    /* Conjuntos disjuntos (union-find) dos vertices, mantidos a cada aresta acrescentada */
+    int *paiConjunto;     /* raiz do conjunto quando paiConjunto[v] == v */
+    int *tamanhoConjunto; /* numero de vertices, valido apenas nas raizes */
+    int numConjuntos;     /* numero de componentes do grafo */
+
+    Vertice vertices[1]; /* tamanho real: ordem do grafo */
+} DadosGrafo;
+
+/*
+Lista com cada aresta do grafo uma unica vez, guardada em dois vetores
+contiguos: a aresta i liga extremo1[i] a extremo2[i]
+*/
+typedef struct listaArestas
+{
+    int *extremo1;
+    int *extremo2;
+    int numArestas;
+} ListaArestas;
+
 /*
  * Declaracao das funcoes para manipulacao de grafos 
  */
 void imprimeGrafo(Vertice G[], int ordem);
 void criaGrafo(Vertice **G, int ordem);
+void liberaGrafo(Vertice G[]);
 int acrescentaAresta(Vertice G[], int ordem, int v1, int v2);
 int calculaTamanho(Vertice G[], int ordem);
-void marcarComponente(Vertice *v, int componente, Vertice G[], int ordem);
+const int *grausGrafo(Vertice G[]);
+int *distribuicaoGraus(Vertice G[], int ordem, int *grauMaximo);
+void marcarComponente(Vertice *v, int componente, Vertice G[], int ordem, int pilha[]);
 void definirComponentesGrafo(Vertice G[], int ordem);
 int numComponentes(Vertice G[], int ordem);
 bool conexo(Vertice G[], int ordem);
+int encontraConjunto(Vertice G[], int v);
+bool mesmaComponente(Vertice G[], int ordem, int v1, int v2);
+int numComponentesConjuntos(Vertice G[]);
+bool conexoConjuntos(Vertice G[]);
+void definirComponentesConjuntos(Vertice G[], int ordem);
+ListaArestas *criaListaArestas(Vertice G[], int ordem);
+void liberaListaArestas(ListaArestas *arestas);
+void definirComponentesArestas(Vertice G[], int ordem, ListaArestas *arestas);
 
 /*
  * Implementacao das funcoes para manipulacao de grafos 
  */
 
+/* Recupera os dados do grafo guardados antes do vetor de vertices */
+static DadosGrafo *dadosGrafo(Vertice G[])
+{
+    return (DadosGrafo *)((char *)G - offsetof(DadosGrafo, vertices));
+}
+
+/* Retira uma celula de aresta da arena, reservando um novo bloco se o atual estiver cheio */
+static Aresta *novaAresta(Vertice G[])
+{
+    DadosGrafo *dados = dadosGrafo(G);
+    BlocoArestas *bloco = dados->blocos;
+
+    if (bloco == NULL || bloco->usadas == ARESTAS_POR_BLOCO)
+    {
+        bloco = (BlocoArestas *)malloc(sizeof(BlocoArestas));
+        bloco->usadas = 0;
+        bloco->prox = dados->blocos;
+        dados->blocos = bloco;
+    }
+
+    return &bloco->celulas[bloco->usadas++];
+}
+
+/* Une os conjuntos de v1 e v2, pendurando a raiz do menor na raiz do maior */
+static void uneConjuntos(Vertice G[], int v1, int v2)
+{
+    DadosGrafo *dados = dadosGrafo(G);
+    int r1 = encontraConjunto(G, v1);
+    int r2 = encontraConjunto(G, v2);
+    int troca;
+
+    if (r1 == r2) /* ja estao na mesma componente */
+        return;
+
+    if (dados->tamanhoConjunto[r1] < dados->tamanhoConjunto[r2])
+    {
+        troca = r1;
+        r1 = r2;
+        r2 = troca;
+    }
+
+    dados->paiConjunto[r2] = r1;
+    dados->tamanhoConjunto[r1] += dados->tamanhoConjunto[r2];
+    dados->numConjuntos--;
+}
+
 /* Criacao de um grafo com ordem predefinida e, inicilamente, sem nenhuma aresta */
 void criaGrafo(Vertice **G, int ordem)
 {
     int i;
-    *G = (Vertice *)malloc(sizeof(Vertice) * ordem);
+    DadosGrafo *dados;
+
+    dados = (DadosGrafo *)malloc(sizeof(DadosGrafo) + sizeof(Vertice) * (ordem > 0 ? ordem - 1 : 0));
+    dados->blocos = NULL;
+    dados->grau = (int *)calloc(ordem > 0 ? ordem : 1, sizeof(int));
+    dados->numArestas = 0;
+    *G = dados->vertices;
+
+    /* Cada vertice comeca sozinho em seu conjunto */
+    dados->paiConjunto = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    dados->tamanhoConjunto = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    dados->numConjuntos = ordem;
 
     for (i = 0; i < ordem; i++)
     {
         (*G)[i].nome = i;
         (*G)[i].componente = COMPONENTE_NAO_DEFINIDO; /* 0: sem componente atribuida */
         (*G)[i].prim = NULL;                          /* Cada vertice sem nenua aresta incidente */
+        dados->paiConjunto[i] = i;
+        dados->tamanhoConjunto[i] = 1;
     }
 }
 
@@ -58,6 +179,7 @@ void criaGrafo(Vertice **G, int ordem)
 /*  Devem ser passados os extremos v1 e v2 da aresta a ser acrescentada  */
 int acrescentaAresta(Vertice G[], int ordem, int v1, int v2)
 {
+    DadosGrafo *dados;
     Aresta *A1;
     Aresta *A2;
 
@@ -67,48 +189,97 @@ int acrescentaAresta(Vertice G[], int ordem, int v1, int v2)
         return 0;
 
     /* Acrescento aresta na lista do vertice v1 */
-    A1 = (Aresta *)malloc(sizeof(Aresta));
+    A1 = novaAresta(G);
     A1->nome = v2;
     A1->prox = G[v1].prim;
     G[v1].prim = A1;
 
     /* Acrescento aresta na lista do vertice v2 */
-    A2 = (Aresta *)malloc(sizeof(Aresta));
+    A2 = novaAresta(G);
     A2->nome = v1;
     A2->prox = G[v2].prim;
     G[v2].prim = A2;
 
+    dados = dadosGrafo(G);
+    dados->grau[v1]++;
+    dados->grau[v2]++;
+    dados->numArestas++;
+
+    /* Os extremos passam a estar na mesma componente */
+    uneConjuntos(G, v1, v2);
+
     return 1;
 }
 
-/*  Funcao que retorna o tamanho de um grafo */
-int calculaTamanho(Vertice G[], int ordem)
+/*  Libera um grafo criado por criaGrafo: blocos de arestas e vetor de vertices */
+void liberaGrafo(Vertice G[])
 {
-    int i;
-    int totalArestas = 0;
+    DadosGrafo *dados = dadosGrafo(G);
+    BlocoArestas *bloco, *anterior;
 
-    for (i = 0; i < ordem; i++)
+    for (bloco = dados->blocos; bloco != NULL; bloco = anterior)
     {
-        int j;
-        Aresta *aux;
-        aux = G[i].prim;
-        for (j = 0; aux != NULL; aux = aux->prox, j++)
-            ; /*contando as iterações*/
-        totalArestas += j;
+        anterior = bloco->prox;
+        free(bloco);
     }
-    return totalArestas / 2 + ordem;
+
+    free(dados->grau);
+    free(dados->paiConjunto);
+    free(dados->tamanhoConjunto);
+    free(dados);
+}
+
+/*  Funcao que retorna o tamanho de um grafo: ordem mais o numero de arestas, mantido por acrescentaAresta */
+int calculaTamanho(Vertice G[], int ordem)
+{
+    return dadosGrafo(G)->numArestas + ordem;
+}
+
+/*  Grau de cada vertice, mantido por acrescentaAresta. O vetor pertence ao grafo */
+const int *grausGrafo(Vertice G[])
+{
+    return dadosGrafo(G)->grau;
+}
+
+/*
+Distribuicao dos graus: a posicao d do vetor devolvido guarda quantos 
+vertices tem grau d, de 0 ate o grau maximo, devolvido em grauMaximo. 
+Uma passada pelo vetor de graus, sem percorrer as listas. O vetor 
+devolvido deve ser liberado com free
+*/
+int *distribuicaoGraus(Vertice G[], int ordem, int *grauMaximo)
+{
+    const int *grau = grausGrafo(G);
+    int *histograma;
+    int i, maximo;
+
+    maximo = 0;
+    for (i = 0; i < ordem; i++)
+        if (grau[i] > maximo)
+            maximo = grau[i];
+
+    histograma = (int *)calloc(maximo + 1, sizeof(int));
+    for (i = 0; i < ordem; i++)
+        histograma[grau[i]]++;
+
+    *grauMaximo = maximo;
+    return histograma;
 }
 
 /*  Imprime um grafo exibindo seus vertices e as arestas incidentes neles */
 void imprimeGrafo(Vertice G[], int ordem)
 {
     int i;
+    int componentes;
     Aresta *aux;
 
+    /*Tamanho e componentes mantidos pelo grafo: nenhuma contagem a cada impressao*/
+    componentes = numComponentesConjuntos(G);
+
     printf("Ordem:       %d\n", ordem);
     printf("Tamanho:     %d\n", calculaTamanho(G, ordem));
-    printf("Componentes: %d\n", numComponentes(G, ordem));
-    printf("Conexo:      %s\n", conexo(G, ordem) ? "sim" : "nao");
+    printf("Componentes: %d\n", componentes);
+    printf("Conexo:      %s\n", componentes == 1 ? "sim" : "nao");
     printf("===Lista de Adjacencia===:\n");
 
     for (i = 0; i < ordem; i++)
@@ -125,12 +296,20 @@ void imprimeGrafo(Vertice G[], int ordem)
 
 /*
 Marca o vertice com o número de seu componente, 
-bem como todos os vertices a ele associados
+bem como todos os vertices a ele associados.
+
+Nao e recursiva: os vertices ja marcados e com vizinhos ainda 
+nao examinados ficam no vetor pilha, que deve ter espaco para 
+ordem vertices e pode ser reaproveitado entre as chamadas
 */
-void marcarComponente(Vertice *v, int componente, Vertice G[], int ordem)
+void marcarComponente(Vertice *v, int componente, Vertice G[], int ordem, int pilha[])
 {
     Aresta *aux;
     Vertice *outroLado;
+    int topo;
+
+    if (v->nome < 0 || v->nome >= ordem) /* Testo se vertice e valido */
+        return;
 
     if (v->componente != COMPONENTE_NAO_DEFINIDO)
     {
@@ -138,63 +317,76 @@ void marcarComponente(Vertice *v, int componente, Vertice G[], int ordem)
         return;
     }
 
+    /*Cada vertice e marcado ao entrar na pilha, entrando no maximo uma vez*/
     v->componente = componente;
-    aux = v->prim;
-    for (; aux != NULL; aux = aux->prox)
+    pilha[0] = v->nome;
+    topo = 1;
+
+    while (topo > 0)
     {
-        outroLado = &G[aux->nome];
-        marcarComponente(outroLado, componente, G, ordem);
+        aux = G[pilha[--topo]].prim;
+        for (; aux != NULL; aux = aux->prox)
+        {
+            outroLado = &G[aux->nome];
+            if (outroLado->componente == COMPONENTE_NAO_DEFINIDO)
+            {
+                outroLado->componente = componente;
+                pilha[topo++] = outroLado->nome;
+            }
+        }
     }
 }
 
 void definirComponentesGrafo(Vertice G[], int ordem)
 {
     int componenteAtual;
+    int *pilha;
     int i;
 
     componenteAtual = 1;
+    pilha = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1)); /*reaproveitada por todas as componentes*/
 
     for (i = 0; i < ordem; i++)
     {
         if (G[i].componente == COMPONENTE_NAO_DEFINIDO)
         {
-            marcarComponente(&G[i], componenteAtual, G, ordem);
+            marcarComponente(&G[i], componenteAtual, G, ordem, pilha);
             componenteAtual++;
         }
     }
+
+    free(pilha);
 }
 
+/*
+Conta as componentes marcadas nos vertices. Como as componentes sao 
+numeradas de 1 ate a ordem, basta marcar cada numero ja encontrado 
+em um vetor: uma unica passada pelos vertices
+*/
 int numComponentes(Vertice G[], int ordem)
 {
-    int *componentesDefinidos;
+    bool *componentesDefinidos;
     int encontrados;
-    int i, j;
-    bool jaDefinido;
+    int i;
 
-    componentesDefinidos = (int *)malloc(ordem * sizeof(int));
+    componentesDefinidos = (bool *)calloc(ordem + 1, sizeof(bool));
     encontrados = 0;
 
     for (i = 0; i < ordem; i++)
     {
-
         int componenteAtual = G[i].componente;
-        if (componenteAtual == COMPONENTE_NAO_DEFINIDO)
+        if (componenteAtual <= COMPONENTE_NAO_DEFINIDO || componenteAtual > ordem)
         {
             /*Executar definirComponentesGrafo(G[], int)*/
             /*Componente não definido encontrado, nao incluso na contagem*/
             continue;
         }
 
-        jaDefinido = false;
-
-        for (j = 0; j < encontrados; j++)
+        if (!componentesDefinidos[componenteAtual])
         {
-            if (componenteAtual == componentesDefinidos[j])
-                jaDefinido = true; /*Componente ja contabilizado, nao incluindo*/
+            componentesDefinidos[componenteAtual] = true;
+            encontrados++;
         }
-
-        if (!jaDefinido)
-            componentesDefinidos[encontrados++] = componenteAtual;
     }
 
     free(componentesDefinidos);
@@ -214,6 +406,224 @@ bool conexo(Vertice G[], int ordem)
     return numComponentes(G, ordem) == 1;
 }
 
+/*
+Devolve a raiz do conjunto do vertice v. No caminho ate a raiz, cada 
+vertice passa a apontar para o seu avo (divisao de caminho)
+*/
+int encontraConjunto(Vertice G[], int v)
+{
+    int *pai = dadosGrafo(G)->paiConjunto;
+    int proximo;
+
+    while (pai[v] != v)
+    {
+        proximo = pai[v];
+        pai[v] = pai[proximo];
+        v = proximo;
+    }
+
+    return v;
+}
+
+bool mesmaComponente(Vertice G[], int ordem, int v1, int v2)
+{
+    if (v1 < 0 || v1 >= ordem || v2 < 0 || v2 >= ordem) /* Testo se vertices sao validos */
+        return false;
+
+    return encontraConjunto(G, v1) == encontraConjunto(G, v2);
+}
+
+/* Numero de componentes, mantido a cada aresta acrescentada */
+int numComponentesConjuntos(Vertice G[])
+{
+    return dadosGrafo(G)->numConjuntos;
+}
+
+/* Mesma definicao de conexo: grafos vazios nao sao conexos */
+bool conexoConjuntos(Vertice G[])
+{
+    return numComponentesConjuntos(G) == 1;
+}
+
+/*
+Marca a componente de todos os vertices a partir dos conjuntos, sem 
+percorrer as arestas. A numeracao e a mesma de definirComponentesGrafo
+*/
+void definirComponentesConjuntos(Vertice G[], int ordem)
+{
+    int *numeroConjunto;
+    int componenteAtual;
+    int i, raiz;
+
+    numeroConjunto = (int *)calloc(ordem > 0 ? ordem : 1, sizeof(int));
+    componenteAtual = 1;
+
+    for (i = 0; i < ordem; i++)
+    {
+        raiz = encontraConjunto(G, i);
+        if (numeroConjunto[raiz] == COMPONENTE_NAO_DEFINIDO)
+            numeroConjunto[raiz] = componenteAtual++;
+        G[i].componente = numeroConjunto[raiz];
+    }
+
+    free(numeroConjunto);
+}
+
+/*
+Monta a lista de arestas a partir das listas de adjacencia. Cada aresta 
+aparece nas listas dos dois extremos, e e incluida apenas pelo de menor 
+nome. Lacos nao ligam vertices diferentes e sao ignorados
+*/
+ListaArestas *criaListaArestas(Vertice G[], int ordem)
+{
+    ListaArestas *arestas;
+    Aresta *aux;
+    int i, total;
+
+    total = 0;
+    for (i = 0; i < ordem; i++)
+        for (aux = G[i].prim; aux != NULL; aux = aux->prox)
+            if (aux->nome > i)
+                total++;
+
+    arestas = (ListaArestas *)malloc(sizeof(ListaArestas));
+    arestas->extremo1 = (int *)malloc(sizeof(int) * (total > 0 ? total : 1));
+    arestas->extremo2 = (int *)malloc(sizeof(int) * (total > 0 ? total : 1));
+    arestas->numArestas = total;
+
+    total = 0;
+    for (i = 0; i < ordem; i++)
+        for (aux = G[i].prim; aux != NULL; aux = aux->prox)
+            if (aux->nome > i)
+            {
+                arestas->extremo1[total] = i;
+                arestas->extremo2[total] = aux->nome;
+                total++;
+            }
+
+    return arestas;
+}
+
+void liberaListaArestas(ListaArestas *arestas)
+{
+    free(arestas->extremo1);
+    free(arestas->extremo2);
+    free(arestas);
+}
+
+/*
+Acerta os rotulos dos extremos de uma aresta cujos rotulos sao diferentes:
+o maior recebe o menor. O vertice que da nome ao rotulo maior tambem recebe 
+o menor, o que leva o rotulo novo a todos que ainda apontam para ele.
+Retorna verdadeiro se algum rotulo mudou
+*/
+static bool propagaRotulo(int rotulo[], int u, int v)
+{
+    int ru = rotulo[u];
+    int rv = rotulo[v];
+
+    if (ru == rv)
+        return false;
+
+    if (ru < rv)
+    {
+        rotulo[v] = ru;
+        if (rotulo[rv] > ru)
+            rotulo[rv] = ru;
+    }
+    else
+    {
+        rotulo[u] = rv;
+        if (rotulo[ru] > rv)
+            rotulo[ru] = rv;
+    }
+    return true;
+}
+
+/*
+Uma passada por todas as arestas, na ordem em que estao nos vetores.
+Com AVX2, os rotulos dos extremos de 8 arestas sao lidos de uma vez 
+(gather) e comparados; apenas as arestas com extremos de rotulos 
+diferentes, cada vez mais raras a cada passada, sao tratadas uma a uma.
+Retorna verdadeiro se algum rotulo mudou
+*/
+static bool passadaArestas(int rotulo[], ListaArestas *arestas)
+{
+    bool mudou = false;
+    int i = 0;
+    int n = arestas->numArestas;
+
+#ifdef __AVX2__
+    __m256i e1, e2, r1, r2;
+    int iguais, k;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        e1 = _mm256_loadu_si256((const __m256i *)&arestas->extremo1[i]);
+        e2 = _mm256_loadu_si256((const __m256i *)&arestas->extremo2[i]);
+        r1 = _mm256_i32gather_epi32(rotulo, e1, 4);
+        r2 = _mm256_i32gather_epi32(rotulo, e2, 4);
+        iguais = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(r1, r2)));
+
+        if (iguais == 0xFF) /* nenhuma das 8 arestas muda algum rotulo */
+            continue;
+
+        for (k = 0; k < 8; k++)
+            if (!(iguais & (1 << k)) && propagaRotulo(rotulo, arestas->extremo1[i + k], arestas->extremo2[i + k]))
+                mudou = true;
+    }
+#endif
+
+    for (; i < n; i++)
+        if (propagaRotulo(rotulo, arestas->extremo1[i], arestas->extremo2[i]))
+            mudou = true;
+
+    return mudou;
+}
+
+/*
+Componentes a partir da lista de arestas, na linha da estrategia do 
+enunciado: as arestas sao consultadas procurando extremos com componentes 
+diferentes, e o extremo de maior rotulo passa para a componente do outro.
+
+Cada vertice comeca com o proprio nome como rotulo, e o rotulo de um vertice 
+e sempre o nome de um vertice menor ou igual da mesma componente. Apos cada 
+passada, os rotulos sao encurtados (rotulo do rotulo), o que reduz bastante 
+o numero de passadas. Quando uma passada nao muda nada, todos os vertices de 
+uma componente tem o rotulo do menor deles.
+
+A numeracao final e a mesma de definirComponentesGrafo
+*/
+void definirComponentesArestas(Vertice G[], int ordem, ListaArestas *arestas)
+{
+    int *rotulo;
+    int componenteAtual;
+    int i;
+
+    rotulo = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    for (i = 0; i < ordem; i++)
+        rotulo[i] = i;
+
+    while (passadaArestas(rotulo, arestas))
+    {
+        /*Em ordem crescente, rotulo[rotulo[i]] ja esta encurtado*/
+        for (i = 0; i < ordem; i++)
+            rotulo[i] = rotulo[rotulo[i]];
+    }
+
+    /*Componentes numeradas a partir de 1, na ordem de seu menor vertice*/
+    componenteAtual = 1;
+    for (i = 0; i < ordem; i++)
+    {
+        if (rotulo[i] == i)
+            G[i].componente = componenteAtual++;
+        else
+            G[i].componente = G[rotulo[i]].componente;
+    }
+
+    free(rotulo);
+}
+
 /*
 Dois vértices, não relacionados por uma aresta
 +-+   +-+
@@ -230,6 +640,7 @@ void testeVerticesIsolados ()
     definirComponentesGrafo(G, ordem);
 
     imprimeGrafo(G, ordem);
+    liberaGrafo(G);
 }
 
 /*
@@ -255,7 +666,7 @@ void testeVerticesConexos ()
     definirComponentesGrafo(G, ordem);
 
     imprimeGrafo(G, ordem);
-    
+    liberaGrafo(G);
 }
 
 /*
@@ -272,6 +683,79 @@ void testeGrafoVazio ()
     definirComponentesGrafo(G, ordem);
 
     imprimeGrafo(G, ordem);
+    liberaGrafo(G);
+}
+
+/*
+Duas componentes, identificadas pela lista de arestas
++-+  +-+  +-+
+|0+--+2+--+4|
++-+  +-+  +-+
++-+  +-+
+|1+--+3|
++-+  +-+
+*/
+void testeComponentesArestas ()
+{
+    Vertice *G;
+    ListaArestas *arestas;
+    int ordem;
+
+    ordem = 5;
+
+    criaGrafo(&G, ordem);
+    acrescentaAresta(G, ordem, 0, 2);
+    acrescentaAresta(G, ordem, 2, 4);
+    acrescentaAresta(G, ordem, 1, 3);
+
+    arestas = criaListaArestas(G, ordem);
+    definirComponentesArestas(G, ordem, arestas);
+
+    imprimeGrafo(G, ordem);
+    liberaListaArestas(arestas);
+    liberaGrafo(G);
+}
+
+/*
+Estrela com centro em 0 e um vertice isolado: graus 4, 1, 1, 1, 1 e 0
+      +-+
+      |1|
+      +++
+       |
++-+  +-+-+  +-+   +-+
+|2+--+ 0 +--+3|   |5|
++-+  +-+-+  +-+   +-+
+       |
+      +++
+      |4|
+      +-+
+*/
+void testeDistribuicaoGraus ()
+{
+    Vertice *G;
+    const int *grau;
+    int *histograma;
+    int ordem, grauMaximo, i;
+
+    ordem = 6;
+
+    criaGrafo(&G, ordem);
+    for (i = 1; i <= 4; i++)
+        acrescentaAresta(G, ordem, 0, i);
+
+    grau = grausGrafo(G);
+    histograma = distribuicaoGraus(G, ordem, &grauMaximo);
+
+    printf("Graus:      ");
+    for (i = 0; i < ordem; i++)
+        printf("%3d", grau[i]);
+    printf("\nHistograma: ");
+    for (i = 0; i <= grauMaximo; i++)
+        printf(" %d:%d", i, histograma[i]);
+    printf("\n\n");
+
+    free(histograma);
+    liberaGrafo(G);
 }
 
 int main(int argc, char *argv[])
@@ -279,6 +763,8 @@ int main(int argc, char *argv[])
     testeVerticesIsolados();
     testeVerticesConexos();
     testeGrafoVazio();
+    testeComponentesArestas();
+    testeDistribuicaoGraus();
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,357 @@
+/*
+ * MEDICAO DE DESEMPENHO
+ *
+ * Mede construcao, buscas e componentes conexas sobre grafos gerados
+ * (R-MAT, Erdos-Renyi, grade e caminho) de tamanhos crescentes.
+ * Cada medicao e repetida e o resultado e impresso em CSV, uma linha por
+ * grafo e operacao: tempos (mediana e percentis), arestas percorridas por
+ * segundo (TEPS, como no Graph500) e o pico de memoria residente do
+ * processo inteiro ate aquela linha. Esse pico so cresce: nao mede a
+ * operacao da linha, e se repete depois do maior grafo.
+ *
+ * Uso: benchmark [escalaMaxima] [repeticoes] [threads]
+ * Compilado com "make bench", sempre com as buscas paralelas
+ * (-DBUSCA_PARALELA), que tambem executa o programa
+ */
+#define SEM_MAIN
+#include "grafo.c"
+
+#include <time.h>
+#include <sys/resource.h>
+
+#define ESCALA_MINIMA 10
+#define ESCALA_MAXIMA_PADRAO 16
+#define REPETICOES_PADRAO 5
+#define FATOR_ARESTAS 16
+#define SEMENTE_BENCHMARK 2019
+
+/**
+ * Como contar as arestas percorridas por uma operacao, para o TEPS
+*/
+#define ARESTAS_ALCANCADAS 1 /* arestas da componente do vertice inicial */
+#define ARESTAS_GRAFO 2      /* todas as arestas do grafo */
+
+typedef struct grafoMedido
+{
+    const char *nome;
+    int ordem;
+    int numArestas;
+    int *arestas;
+    int numThreads;
+
+    Vertice *G;
+    GrafoCSR *csr;
+    GrafoCSR *csrRCM; /* vertices reordenados por Cuthill-McKee reverso */
+    Reordenacao *reordenacaoRCM;
+    GrafoCSR *csrBusca; /* grafo da ultima busca em largura, para contar as arestas */
+    ResultadoBuscaLargura *largura;
+    ResultadoBuscaProfundidade *profundidade;
+    int *componente;
+
+    /* grafos montados pelas operacoes de construcao, liberados fora da medicao */
+    Vertice *GConstruido;
+    GrafoCSR *csrConstruido;
+} GrafoMedido;
+
+typedef void (*OperacaoMedida)(GrafoMedido *g, int verticeInicial);
+
+typedef struct medicao
+{
+    const char *nome;
+    OperacaoMedida operacao;
+    int contagemArestas;
+} Medicao;
+
+static void constroiLista(GrafoMedido *g, int verticeInicial)
+{
+    int i;
+    (void)verticeInicial;
+
+    criaGrafo(&g->GConstruido, g->ordem);
+    for (i = 0; i < g->numArestas; i++)
+        acrescentaAresta(g->GConstruido, g->ordem, g->arestas[2 * i], g->arestas[2 * i + 1]);
+}
+
+static void constroiCSR(GrafoMedido *g, int verticeInicial)
+{
+    (void)verticeInicial;
+    g->csrConstruido = criaGrafoCSRArestas(g->ordem, g->arestas, g->numArestas);
+}
+
+static void constroiCSRParalelo(GrafoMedido *g, int verticeInicial)
+{
+    (void)verticeInicial;
+    g->csrConstruido = criaGrafoCSRParalelo(g->ordem, g->arestas, g->numArestas,
+                                            CONSTRUCAO_SEM_REPETIDAS | CONSTRUCAO_SEM_LACOS, g->numThreads);
+}
+
+static void larguraLista(GrafoMedido *g, int verticeInicial)
+{
+    g->csrBusca = g->csr;
+    buscaLargura(g->G, g->ordem, verticeInicial, g->largura);
+}
+
+static void larguraCSR(GrafoMedido *g, int verticeInicial)
+{
+    g->csrBusca = g->csr;
+    buscaLarguraCSR(g->csr, verticeInicial, g->largura);
+}
+
+static void larguraHibrida(GrafoMedido *g, int verticeInicial)
+{
+    g->csrBusca = g->csr;
+    buscaLarguraHibridaCSR(g->csr, verticeInicial, g->largura);
+}
+
+static void larguraParalela(GrafoMedido *g, int verticeInicial)
+{
+    g->csrBusca = g->csr;
+    buscaLarguraParalelaCSR(g->csr, verticeInicial, g->numThreads, g->largura);
+}
+
+/* O resultado fica nos novos nomes: a traducao nao faz parte da medicao */
+static void larguraRCM(GrafoMedido *g, int verticeInicial)
+{
+    g->csrBusca = g->csrRCM;
+    buscaLarguraCSR(g->csrRCM, g->reordenacaoRCM->novoNome[verticeInicial], g->largura);
+}
+
+static void profundidadeLista(GrafoMedido *g, int verticeInicial)
+{
+    (void)verticeInicial;
+    buscaProfundida(g->G, g->ordem, g->profundidade);
+}
+
+static void profundidadeCSR(GrafoMedido *g, int verticeInicial)
+{
+    (void)verticeInicial;
+    buscaProfundidaCSR(g->csr, g->profundidade);
+}
+
+static void componentesBusca(GrafoMedido *g, int verticeInicial)
+{
+    (void)verticeInicial;
+    buscaProfundida(g->G, g->ordem, g->profundidade);
+    numComponentes(g->profundidade->componente, g->ordem);
+}
+
+static void componentesParalelo(GrafoMedido *g, int verticeInicial)
+{
+    (void)verticeInicial;
+    definirComponentesParaleloCSR(g->csr, g->componente, g->numThreads);
+    numComponentes(g->componente, g->ordem);
+}
+
+static const Medicao medicoes[] = {
+    {"construcao_lista", constroiLista, ARESTAS_GRAFO},
+    {"construcao_csr", constroiCSR, ARESTAS_GRAFO},
+    {"construcao_csr_paralela", constroiCSRParalelo, ARESTAS_GRAFO},
+    {"largura_lista", larguraLista, ARESTAS_ALCANCADAS},
+    {"largura_csr", larguraCSR, ARESTAS_ALCANCADAS},
+    {"largura_hibrida", larguraHibrida, ARESTAS_ALCANCADAS},
+    {"largura_paralela", larguraParalela, ARESTAS_ALCANCADAS},
+    {"largura_rcm", larguraRCM, ARESTAS_ALCANCADAS},
+    {"profundidade_lista", profundidadeLista, ARESTAS_GRAFO},
+    {"profundidade_csr", profundidadeCSR, ARESTAS_GRAFO},
+    {"componentes_busca", componentesBusca, ARESTAS_GRAFO},
+    {"componentes_paralelo", componentesParalelo, ARESTAS_GRAFO}};
+
+/* Tempo atual em segundos, de um relogio que nao volta para tras */
+static double agora(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/* Maior memoria residente usada pelo processo desde o inicio (ru_maxrss), em KB */
+static long picoRSSProcessoKB(void)
+{
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+static int comparaReais(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Percentil p (entre 0 e 1) de valores ja ordenados, pelo posto mais proximo */
+static double percentil(double ordenados[], int n, double p)
+{
+    int posicao = (int)(p * n + 0.999999) - 1;
+
+    if (posicao < 0)
+        posicao = 0;
+    if (posicao >= n)
+        posicao = n - 1;
+    return ordenados[posicao];
+}
+
+/**
+ * Arestas da componente alcancada pela ultima busca em largura:
+ * metade da soma dos graus dos vertices visitados
+*/
+static double arestasAlcancadas(GrafoMedido *g)
+{
+    double semiArestas = 0;
+    int v;
+
+    for (v = 0; v < g->ordem; v++)
+        if (TESTA_BIT(g->largura->visitados, v))
+            semiArestas += g->csrBusca->inicio[v + 1] - g->csrBusca->inicio[v];
+
+    return semiArestas / 2;
+}
+
+/**
+ * Sorteia o vertice inicial de cada repeticao entre os vertices
+ * com pelo menos uma aresta, como no Graph500
+*/
+static int sorteiaVerticeInicial(GrafoMedido *g, unsigned int *estado)
+{
+    int tentativa, v;
+
+    v = 0;
+    for (tentativa = 0; tentativa < 64; tentativa++)
+    {
+        v = proximoVerticeAleatorio(estado, g->ordem);
+        if (g->csr->inicio[v + 1] > g->csr->inicio[v])
+            break;
+    }
+    return v;
+}
+
+static void mede(GrafoMedido *g, const Medicao *medicao, int repeticoes)
+{
+    double *tempos = (double *)malloc(sizeof(double) * repeticoes);
+    double *teps = (double *)malloc(sizeof(double) * repeticoes);
+    unsigned int estado = SEMENTE_BENCHMARK;
+    double inicio, arestas;
+    int r, verticeInicial;
+
+    for (r = 0; r < repeticoes; r++)
+    {
+        verticeInicial = sorteiaVerticeInicial(g, &estado);
+
+        inicio = agora();
+        medicao->operacao(g, verticeInicial);
+        tempos[r] = agora() - inicio;
+
+        if (medicao->contagemArestas == ARESTAS_ALCANCADAS)
+            arestas = arestasAlcancadas(g);
+        else
+            arestas = g->numArestas;
+        teps[r] = tempos[r] > 0 ? arestas / tempos[r] : 0;
+
+        if (g->GConstruido != NULL)
+            liberaGrafo(g->GConstruido);
+        if (g->csrConstruido != NULL)
+            liberaGrafoCSR(g->csrConstruido);
+        g->GConstruido = NULL;
+        g->csrConstruido = NULL;
+    }
+
+    qsort(tempos, repeticoes, sizeof(double), comparaReais);
+    qsort(teps, repeticoes, sizeof(double), comparaReais);
+
+    printf("%s,%d,%d,%s,%d,%d,%.9f,%.9f,%.9f,%.9f,%.9f,%.0f,%ld\n", g->nome, g->ordem, g->numArestas,
+           medicao->nome, g->numThreads, repeticoes,
+           tempos[0], percentil(tempos, repeticoes, 0.1), percentil(tempos, repeticoes, 0.5),
+           percentil(tempos, repeticoes, 0.9), tempos[repeticoes - 1],
+           percentil(teps, repeticoes, 0.5), picoRSSProcessoKB());
+    fflush(stdout);
+
+    free(tempos);
+    free(teps);
+}
+
+/* Monta as duas representacoes do grafo e executa todas as medicoes */
+static void medeGrafo(const char *nome, int ordem, int *arestas, int numArestas, int repeticoes, int numThreads)
+{
+    GrafoMedido g;
+    int i;
+
+    if (arestas == NULL)
+        return;
+
+    g.nome = nome;
+    g.ordem = ordem;
+    g.arestas = arestas;
+    g.numArestas = numArestas;
+    g.numThreads = numThreads;
+    g.GConstruido = NULL;
+    g.csrConstruido = NULL;
+
+    criaGrafo(&g.G, ordem);
+    for (i = 0; i < numArestas; i++)
+        acrescentaAresta(g.G, ordem, arestas[2 * i], arestas[2 * i + 1]);
+    g.csr = criaGrafoCSRArestas(ordem, arestas, numArestas);
+    g.reordenacaoRCM = calculaReordenacaoCSR(g.csr, REORDENACAO_RCM);
+    g.csrRCM = reordenaGrafoCSR(g.csr, g.reordenacaoRCM, numThreads);
+    g.csrBusca = g.csr;
+    g.largura = criaResultadoBuscaLargura(ordem);
+    g.profundidade = criaResultadoBuscaProfundidade(ordem);
+    g.componente = (int *)malloc(sizeof(int) * ordem);
+
+    for (i = 0; i < (int)(sizeof(medicoes) / sizeof(medicoes[0])); i++)
+        mede(&g, &medicoes[i], repeticoes);
+
+    free(g.componente);
+    liberaResultadoBuscaLargura(g.largura);
+    liberaResultadoBuscaProfundidade(g.profundidade);
+    liberaGrafoCSR(g.csrRCM);
+    liberaReordenacao(g.reordenacaoRCM);
+    liberaGrafoCSR(g.csr);
+    liberaGrafo(g.G);
+    free(arestas);
+}
+
+int main(int argc, char *argv[])
+{
+    int escalaMaxima = ESCALA_MAXIMA_PADRAO;
+    int repeticoes = REPETICOES_PADRAO;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int *arestas;
+    int escala, ordem, numArestas;
+
+    if (argc > 1)
+        escalaMaxima = atoi(argv[1]);
+    if (argc > 2)
+        repeticoes = atoi(argv[2]);
+    if (argc > 3)
+        numThreads = atoi(argv[3]);
+    if (repeticoes < 1)
+        repeticoes = 1;
+    if (numThreads < 1)
+        numThreads = 1;
+#ifndef BUSCA_PARALELA
+    numThreads = 1; /* sem pthreads, as versoes paralelas rodam em uma thread */
+#endif
+
+    printf("grafo,ordem,arestas,operacao,threads,repeticoes,"
+           "tempo_min_s,tempo_p10_s,tempo_mediana_s,tempo_p90_s,tempo_max_s,teps_mediana,pico_rss_processo_kb\n");
+
+    for (escala = ESCALA_MINIMA; escala <= escalaMaxima; escala += 2)
+    {
+        ordem = 1 << escala;
+
+        /*Os geradores escrevem numArestas, entao sao chamados antes de medeGrafo*/
+        arestas = geraArestasRMAT(escala, FATOR_ARESTAS, SEMENTE_BENCHMARK, numThreads, &numArestas);
+        medeGrafo("rmat", ordem, arestas, numArestas, repeticoes, numThreads);
+
+        arestas = geraArestasErdosRenyi(ordem, FATOR_ARESTAS * ordem, SEMENTE_BENCHMARK, numThreads, &numArestas);
+        medeGrafo("erdos_renyi", ordem, arestas, numArestas, repeticoes, numThreads);
+
+        arestas = geraArestasGrade(1 << (escala / 2), 1 << (escala - escala / 2), numThreads, &numArestas);
+        medeGrafo("grade", ordem, arestas, numArestas, repeticoes, numThreads);
+
+        arestas = geraArestasCaminho(ordem, numThreads, &numArestas);
+        medeGrafo("caminho", ordem, arestas, numArestas, repeticoes, numThreads);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -4,10 +4,37 @@
  * Daniel Dias de Lima      31687679
  * Leandro Alexandre        31616720
  */
+#define _POSIX_C_SOURCE 200112L /* mmap, pthread_barrier_t */
+#ifdef CONTADORES_HARDWARE
+#define _GNU_SOURCE /* syscall */
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <stddef.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef BUSCA_PARALELA
+#include <pthread.h>
+#endif
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#ifdef CONTADORES_HARDWARE
+#include <stdint.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
 
 /**
  * Definição das cores dos algoritmos de busca
@@ -18,12 +45,98 @@
 
 #define ELEMENTO_NAO_DEFINIDO -1
 
+/**
+ * Parametros da busca em largura hibrida (de cima para baixo / de baixo para cima).
+ * A busca passa a ser de baixo para cima quando as arestas da fronteira passam de
+ * 1/ALFA das arestas ainda nao exploradas, e volta quando a fronteira tem menos
+ * de 1/BETA dos vertices do grafo
+*/
+#define ALFA_BUSCA_HIBRIDA 14
+#define BETA_BUSCA_HIBRIDA 24
+
+/**
+ * Busca em largura paralela: as threads retiram da fronteira blocos
+ * de BLOCO_FRONTEIRA vertices por vez, e guardam os vertices descobertos
+ * em um buffer proprio de TAMANHO_BUFFER_THREAD posicoes, copiado para
+ * a proxima fronteira quando cheio ou ao fim do nivel
+*/
+#define BLOCO_FRONTEIRA 64
+#define TAMANHO_BUFFER_THREAD 1024
+
+/**
+ * Componentes conexas paralelas (Afforest): numero de vizinhos de cada
+ * vertice ligados antes da amostragem, e tamanho da amostra usada para
+ * descobrir a maior componente, cujos vertices nao precisam ser revisitados
+*/
+#define RODADAS_VIZINHOS_COMPONENTES 2
+#define AMOSTRAS_COMPONENTES 1024
+
+/**
+ * Leitura de listas de arestas em texto: capacidade inicial
+ * do vetor de arestas lidas por cada pedaco do arquivo
+*/
+#define ARESTAS_INICIAIS_PEDACO 4096
+
+/**
+ * Opcoes da construcao paralela do grafo CSR, combinadas com |.
+ * Trechos de listas de vizinhos com ate VIZINHOS_ORDENACAO_SIMPLES
+ * vertices sao ordenados por insercao
+*/
+#define CONSTRUCAO_ORDENADA 1      /* vizinhos de cada vertice em ordem crescente */
+#define CONSTRUCAO_SEM_REPETIDAS 2 /* arestas repetidas viram uma so (implica ordenada) */
+#define CONSTRUCAO_SEM_LACOS 4     /* arestas de um vertice para ele mesmo sao descartadas */
+
+#define VIZINHOS_ORDENACAO_SIMPLES 16
+
+/**
+ * Gerador R-MAT: probabilidades de cada aresta cair em cada quadrante
+ * da matriz de adjacencia, a cada nivel (valores do Graph500).
+ * O quarto quadrante fica com o restante, 1 - A - B - C
+*/
+#define PROBABILIDADE_RMAT_A 0.57
+#define PROBABILIDADE_RMAT_B 0.19
+#define PROBABILIDADE_RMAT_C 0.19
+
+/**
+ * Instrumentacao das buscas, ligada com INSTRUMENTACAO (make INSTRUMENTAR=1).
+ * Sem ela, as macros abaixo nao geram nenhum codigo.
+ * 
+ * Os contadores sao zerados no inicio de cada busca e podem ser lidos
+ * ou impressos ao fim dela: arestas examinadas, vertices colocados na fila
+ * (ou na proxima fronteira), tamanho da fronteira de cada nivel da busca
+ * em largura e maior profundidade da pilha da busca em profundidade
+*/
+#ifdef INSTRUMENTACAO
+#define CONTA_ARESTAS(n) (contadoresBusca.arestasExaminadas += (n))
+#define CONTA_ENFILEIRAMENTOS(n) (contadoresBusca.enfileiramentos += (n))
+#define CONTA_ARESTAS_ATOMICO(n) __sync_fetch_and_add(&contadoresBusca.arestasExaminadas, (unsigned long)(n))
+#define CONTA_ENFILEIRAMENTOS_ATOMICO(n) __sync_fetch_and_add(&contadoresBusca.enfileiramentos, (unsigned long)(n))
+#define REGISTRA_FRONTEIRA(nivel, n) registraFronteira(nivel, n)
+#define REGISTRA_PROFUNDIDADE(p) ((p) > contadoresBusca.profundidadeMaxima ? contadoresBusca.profundidadeMaxima = (p) : 0)
+#define ZERA_CONTADORES() zeraContadoresBusca()
+#else
+#define CONTA_ARESTAS(n) ((void)0)
+#define CONTA_ENFILEIRAMENTOS(n) ((void)0)
+#define CONTA_ARESTAS_ATOMICO(n) ((void)0)
+#define CONTA_ENFILEIRAMENTOS_ATOMICO(n) ((void)0)
+#define REGISTRA_FRONTEIRA(nivel, n) ((void)0)
+#define REGISTRA_PROFUNDIDADE(p) ((void)0)
+#define ZERA_CONTADORES() ((void)0)
+#endif
+
+/**
+ * Contadores de hardware (CONTADORES_HARDWARE, make PERF=1), lidos com
+ * perf_event_open do Linux: instrucoes, ciclos e acessos e faltas na cache
+*/
+#define NUM_EVENTOS_HARDWARE 4
+
 /* 
  * Estrutura de dados para representar grafos
  */
 typedef struct aresta
 { /* Celula de uma lista de arestas */
     int nome;
+    int floresta; /* 1 se a aresta pertence a floresta geradora mantida pelo grafo */
     struct aresta *prox;
 } Aresta;
 
@@ -32,16 +145,229 @@ typedef struct vert
     int nome;
     int componente;
     Aresta *prim;
+} Vertice;
 
-    int paiBuscaLargura;
-    int corBuscaLargura;
-    int distanciaBuscaLargura;
+/**
+ * Mapa de bits: um bit por vertice, guardado em palavras de PalavraBits.
+ * Usado no lugar das cores das buscas: ao fim de uma busca, um vertice
+ * ou foi visitado (preto) ou nao foi (branco)
+*/
+typedef unsigned int PalavraBits;
 
-    int paiBuscaProfundida;
-    int tempoDescobertaBuscaProf;
-    int tempoFinalizacaoBuscaProf;
-    int corBuscaProfundida;
-} Vertice;
+#define BITS_POR_PALAVRA ((int)(sizeof(PalavraBits) * CHAR_BIT))
+#define PALAVRAS_MAPA_BITS(n) (((n) + BITS_POR_PALAVRA - 1) / BITS_POR_PALAVRA)
+#define TESTA_BIT(mapa, v) (((mapa)[(v) / BITS_POR_PALAVRA] >> ((v) % BITS_POR_PALAVRA)) & 1u)
+#define MARCA_BIT(mapa, v) ((mapa)[(v) / BITS_POR_PALAVRA] |= 1u << ((v) % BITS_POR_PALAVRA))
+
+/**
+ * Resultado de uma busca em largura, guardado fora do grafo, em um vetor
+ * para cada informacao. A busca percorre apenas os vetores de que precisa,
+ * e varias buscas podem ser feitas ao mesmo tempo sobre o mesmo grafo,
+ * cada uma com o seu resultado
+*/
+typedef struct resultadoBuscaLargura
+{
+    int ordem;
+    int *pai;
+    int *distancia;
+    PalavraBits *visitados;
+} ResultadoBuscaLargura;
+
+/**
+ * Resultado de uma busca em profundidade, tambem fora do grafo.
+ * A componente de cada vertice e o nome do vertice que iniciou sua visita
+*/
+typedef struct resultadoBuscaProfundidade
+{
+    int ordem;
+    int *pai;
+    int *tempoDescoberta;
+    int *tempoFinalizacao;
+    int *componente;
+    PalavraBits *visitados;
+} ResultadoBuscaProfundidade;
+
+/**
+ * Busca em largura com varias fontes: cada vertice guarda uma mascara com
+ * um bit por fonte, e um lote de FONTES_POR_LOTE fontes percorre o grafo
+ * de uma so vez, examinando cada aresta uma vez por nivel para todo o lote
+*/
+typedef unsigned long MascaraFontes;
+
+#define FONTES_POR_LOTE ((int)(sizeof(MascaraFontes) * CHAR_BIT))
+
+/**
+ * Resultado da busca com varias fontes. A distancia de cada fonte a cada
+ * vertice so e guardada se pedida (numFontes x ordem inteiros); os totais
+ * por fonte, usados em centralidade e excentricidade, sempre sao
+*/
+typedef struct resultadoBuscaMultipla
+{
+    int ordem;
+    int numFontes;
+    int *distancia;              /* distancia[(size_t)f * ordem + v], ou NULL */
+    int *alcancados;             /* vertices alcancados pela fonte, incluindo ela */
+    int *excentricidade;         /* maior distancia a partir da fonte */
+    unsigned long *somaDistancias; /* soma das distancias a partir da fonte */
+} ResultadoBuscaMultipla;
+
+/**
+ * Busca em largura bidirecional entre dois vertices: uma busca a partir de
+ * cada extremo, avancando sempre a de menor fronteira, ate que se encontrem.
+ * Lado 0 comeca em u e lado 1 em v. Os vetores sao reaproveitados entre
+ * consultas: um vertice so foi visto na consulta atual se sua marca for
+ * igual a consulta, e nao e preciso limpar nada entre uma consulta e outra
+*/
+typedef struct buscaBidirecional
+{
+    struct grafoCSR *csr;
+    int consulta;
+    int *marca[2];
+    int *distancia[2];
+    int *pai[2];
+    int *fila[2];
+} BuscaBidirecional;
+
+/**
+ * Oraculo de distancias por vertices de referencia: a distancia de cada
+ * vertice a cada referencia e calculada uma vez, e a distancia entre u e v
+ * e limitada pela desigualdade triangular, para cada referencia l:
+ * 
+ *   |d(l, u) - d(l, v)| <= d(u, v) <= d(l, u) + d(l, v)
+ * 
+ * As distancias sao guardadas em 16 bits, vertice a vertice, para que uma
+ * consulta leia apenas duas linhas contiguas da tabela
+*/
+typedef unsigned short DistanciaReferencia;
+
+#define REFERENCIA_INALCANCAVEL 65535 /* vertice fora da componente da referencia */
+#define REFERENCIA_DISTANTE 65534     /* distancia grande demais para 16 bits: sem limite */
+
+#define REFERENCIAS_POR_GRAU 1
+#define REFERENCIAS_ALEATORIAS 2
+
+typedef struct oraculoDistancias
+{
+    struct grafoCSR *csr;
+    int numReferencias;
+    int *referencias;
+    DistanciaReferencia *distancias; /* distancias[(size_t)v * numReferencias + i] */
+    BuscaBidirecional *bidirecional; /* usada nas consultas exatas */
+} OraculoDistancias;
+
+/**
+ * Resultado da analise de biconexidade (Tarjan) sobre uma busca em profundidade.
+ * 
+ * Cada aresta da arvore de busca (pai[v], v) e identificada pelo vertice v.
+ * As componentes biconexas particionam as arestas: a de uma aresta de
+ * retorno e a mesma da aresta da arvore que chega ao seu extremo mais
+ * profundo. Por isso basta guardar uma componente por vertice
+*/
+typedef struct resultadoBiconexas
+{
+    int ordem;
+    ResultadoBuscaProfundidade *profundidade; /* pai e tempos da busca */
+    int *menorAlcancavel;                     /* menor tempoDescoberta alcancavel da subarvore (low) */
+    int *componente;                          /* componente biconexa de (pai[v], v); ELEMENTO_NAO_DEFINIDO nas raizes */
+    PalavraBits *articulacao;                 /* vertices cuja remocao desconecta a componente */
+    PalavraBits *ponte;                       /* bit v: (pai[v], v) e ponte */
+    int numArticulacoes;
+    int numPontes;
+    int numComponentes;
+} ResultadoBiconexas;
+
+/**
+ * Renomeacao dos vertices para que vizinhos fiquem proximos na memoria.
+ * O grafo reordenado e um novo grafo CSR, em que o vertice v do original
+ * se chama novoNome[v]; resultados de buscas sobre ele sao trazidos de
+ * volta aos nomes originais com as funcoes traduz...
+*/
+#define REORDENACAO_RCM 1     /* Cuthill-McKee reverso: reduz a largura de banda */
+#define REORDENACAO_GRAU 2    /* graus decrescentes: vertices mais acessados juntos */
+#define REORDENACAO_LARGURA 3 /* ordem de descoberta de uma busca em largura */
+
+typedef struct reordenacao
+{
+    int ordem;
+    int *novoNome;     /* nome de cada vertice original no grafo reordenado */
+    int *nomeOriginal; /* inverso de novoNome */
+} Reordenacao;
+
+/**
+ * Bloco de memoria de onde sao retiradas as celulas de aresta.
+ * Em vez de um malloc por aresta, as celulas sao reservadas em
+ * blocos grandes, liberados todos de uma vez junto com o grafo
+*/
+#define ARESTAS_POR_BLOCO 4096
+
+typedef struct blocoArestas
+{
+    struct blocoArestas *prox; /* bloco reservado anteriormente */
+    int usadas;
+    Aresta celulas[ARESTAS_POR_BLOCO];
+} BlocoArestas;
+
+/**
+ * Atualizacoes aplicadas em lote por aplicaAtualizacoes: cada uma
+ * acrescenta ou remove uma aresta, na ordem em que aparecem no vetor
+*/
+#define ATUALIZACAO_ACRESCENTA 1
+#define ATUALIZACAO_REMOVE 2
+
+typedef struct atualizacaoAresta
+{
+    int operacao; /* ATUALIZACAO_ACRESCENTA ou ATUALIZACAO_REMOVE */
+    int v1;
+    int v2;
+} AtualizacaoAresta;
+
+/**
+ * Vetores de apoio a busca por aresta substituta, feita quando uma
+ * aresta da floresta geradora e removida. Sao reservados na primeira
+ * remocao desse tipo e reaproveitados nas seguintes
+*/
+typedef struct apoioRemocao
+{
+    int *marca; /* 2 * epoca + lado, para os vertices alcancados na busca atual */
+    int epoca;  /* evita limpar marca a cada busca */
+    int *alcancados[2]; /* tambem servem de fila da busca de cada lado */
+    Aresta **cursor;    /* proxima celula a examinar de cada vertice na fila */
+} ApoioRemocao;
+
+/**
+ * Dados do grafo como um todo. Ficam na mesma alocacao do vetor
+ * de vertices, logo antes dele, de forma que as funcoes continuam
+ * recebendo apenas o vetor G e a ordem.
+ * 
+ * Apenas vetores criados por criaGrafo possuem esses dados
+*/
+typedef struct dadosGrafo
+{
+    BlocoArestas *blocos; /* arena de arestas, com o bloco atual a frente */
+
+    Aresta *livres;       /* celulas devolvidas por removeAresta, reaproveitadas antes da arena */
+
+    /* Contagens mantidas a cada aresta acrescentada ou removida, sem percorrer as listas */
+    int *grau;      /* celulas na lista de cada vertice: um laco conta duas vezes */
+    int numArestas; /* arestas presentes no grafo */
+
+    /**
+     * Conjuntos disjuntos (union-find), mantidos a cada aresta acrescentada
+     * ou removida. Os conjuntos sao formados por nos: cada vertice aponta
+     * para um no, e um conjunto separado por uma remocao ganha um no novo,
+     * sem mexer nos caminhos dos vertices que ficaram no conjunto antigo
+    */
+    int *noVertice;       /* no de cada vertice */
+    int *paiConjunto;     /* raiz do conjunto quando paiConjunto[no] == no */
+    int *tamanhoConjunto; /* numero de vertices, valido apenas nas raizes */
+    int numNos;           /* nos em uso, no maximo 2 * ordem */
+    int numConjuntos;     /* numero de componentes do grafo */
+    int ordem;
+
+    ApoioRemocao *remocao;
+
+    Vertice vertices[1]; /* tamanho real: ordem do grafo */
+} DadosGrafo;
 
 /**
  * Estrutura usada para fazer o controle dos vertices 
@@ -58,28 +384,343 @@ typedef struct fila
     int indiceInsercao;
 } Fila;
 
+/**
+ * Pilha usada na busca em profundidade, no lugar da recursao.
+ * 
+ * Cada item guarda um vertice ainda nao finalizado e a posicao do
+ * proximo vizinho dele a ser examinado. Como um vertice so entra
+ * uma vez, a pilha guarda, no maximo, a ordem do grafo
+*/
+typedef struct itemPilha
+{
+    int vertice;
+    union
+    {
+        struct aresta *aresta; /* busca sobre listas de adjacencia */
+        int posicao;           /* busca sobre o grafo CSR */
+        struct
+        {
+            size_t byte;  /* posicao do proximo vizinho em bytes */
+            int anterior; /* ultimo vizinho lido, base da proxima diferenca */
+        } comprimido;     /* busca sobre o grafo comprimido */
+    } proximo;
+} ItemPilha;
+
+typedef struct pilha
+{
+    ItemPilha *itens;
+    int tamanhoMax;
+    int topo; /* quantidade de itens empilhados */
+} Pilha;
+
+/**
+ * Estado compartilhado pelas threads da busca em largura paralela.
+ * Cada nivel e expandido por todas as threads ao mesmo tempo, e elas se
+ * esperam na barreira antes de comecar o proximo
+*/
+typedef struct buscaParalela
+{
+    struct grafoCSR *csr;
+    ResultadoBuscaLargura *resultado;
+    int *fronteira;
+    int *proxima;
+    int tamanhoFronteira;
+    int tamanhoProxima; /* atualizado atomicamente */
+    int proximoBloco;   /* posicao da fronteira ainda nao retirada, atualizada atomicamente */
+    int nivel;
+    int numThreads;
+#ifdef BUSCA_PARALELA
+    pthread_barrier_t barreira;
+#endif
+} BuscaParalela;
+
+#ifdef INSTRUMENTACAO
+typedef struct contadoresBusca
+{
+    unsigned long arestasExaminadas;
+    unsigned long enfileiramentos;
+    int profundidadeMaxima;
+    int niveis;
+    int capacidadeNiveis;
+    int *tamanhoFronteira; /* vertices descobertos em cada nivel */
+} ContadoresBusca;
+
+/* Contadores da ultima busca executada */
+static ContadoresBusca contadoresBusca;
+#endif
+
+#ifdef CONTADORES_HARDWARE
+typedef struct contadoresHardware
+{
+    int descritores[NUM_EVENTOS_HARDWARE]; /* -1: evento indisponivel */
+    uint64_t valores[NUM_EVENTOS_HARDWARE];
+} ContadoresHardware;
+#endif
+
+typedef struct threadBusca
+{
+    BuscaParalela *busca;
+    int indice; /* a thread 0 e a que chamou a busca */
+} ThreadBusca;
+
+/**
+ * Representacao compacta (CSR - compressed sparse row) de um grafo.
+ *
+ * Os vizinhos do vertice i ficam contiguos na memoria, em
+ * vizinhos[inicio[i]] ate vizinhos[inicio[i + 1] - 1]. E uma forma
+ * "congelada" do grafo: depois de criada nao aceita novas arestas
+*/
+typedef struct grafoCSR
+{
+    int ordem;
+    int numSemiArestas; /* cada aresta aparece duas vezes, uma em cada extremo */
+    int *inicio;        /* ordem + 1 posicoes */
+    int *vizinhos;      /* numSemiArestas posicoes */
+
+    /* Quando carregado de arquivo, inicio e vizinhos apontam para este mapeamento */
+    void *mapeamento;
+    size_t tamanhoMapeamento;
+} GrafoCSR;
+
+/**
+ * Representacao comprimida do grafo, somente leitura, para grafos que nao
+ * cabem na memoria como CSR. Cada lista de vizinhos e ordenada e guardada
+ * como diferencas entre vizinhos consecutivos, cada uma em um inteiro de
+ * tamanho variavel (7 bits por byte; o bit mais alto indica que ha mais
+ * bytes). O primeiro vizinho e guardado como diferenca para o proprio
+ * vertice, com sinal (zigue-zague: 0, -1, 1, -2... viram 0, 1, 2, 3...).
+ * 
+ * A lista de v ocupa bytes[inicio[v]] ate bytes[inicio[v + 1] - 1]
+*/
+typedef struct grafoComprimido
+{
+    int ordem;
+    int numSemiArestas;
+    size_t *inicio;       /* ordem + 1 posicoes, em bytes */
+    unsigned char *bytes; /* inicio[ordem] bytes */
+} GrafoComprimido;
+
+/**
+ * Representacao densa: matriz de adjacencia em bits. A linha de v ocupa
+ * palavrasLinha palavras a partir de matriz[v * palavrasLinha], e o bit w
+ * dessa linha indica a aresta (v, w). Guarda apenas grafos simples: lacos
+ * sao descartados e arestas repetidas viram uma so
+*/
+typedef struct grafoDenso
+{
+    int ordem;
+    int palavrasLinha;
+    PalavraBits *matriz;
+} GrafoDenso;
+
+/**
+ * Grafo simples em uma das duas representacoes, escolhida pela densidade
+ * em criaGrafoAutomatico: exatamente um dos ponteiros nao e NULL
+*/
+typedef struct grafoAutomatico
+{
+    int ordem;
+    GrafoCSR *csr;     /* listas ordenadas, sem lacos nem repetidas */
+    GrafoDenso *denso;
+} GrafoAutomatico;
+
+/**
+ * Arquivo binario de um grafo CSR: este cabecalho, seguido do vetor
+ * inicio (ordem + 1 inteiros) e do vetor vizinhos (numSemiArestas inteiros),
+ * exatamente como ficam na memoria (inteiros na ordem de bytes da maquina).
+ * Assim o arquivo pode ser mapeado e percorrido sem nenhuma copia
+*/
+#define ASSINATURA_ARQUIVO_GRAFO "GRAFOCSR"
+#define VERSAO_ARQUIVO_GRAFO 1
+
+typedef struct cabecalhoArquivoGrafo
+{
+    char assinatura[8]; /* ASSINATURA_ARQUIVO_GRAFO, sem o '\0' */
+    int versao;
+    int ordem;
+    int numSemiArestas;
+    int reservado; /* sempre zero */
+} CabecalhoArquivoGrafo;
+
 /*
  * Declaracao das funcoes para manipulacao de grafos 
  */
 void imprimeGrafo(Vertice G[], int ordem);
 void criaGrafo(Vertice **G, int ordem);
+void liberaGrafo(Vertice G[]);
 int acrescentaAresta(Vertice G[], int ordem, int v1, int v2);
+int removeAresta(Vertice G[], int ordem, int v1, int v2);
+int aplicaAtualizacoes(Vertice G[], int ordem, AtualizacaoAresta atualizacoes[], int numAtualizacoes);
 int calculaTamanho(Vertice G[], int ordem);
+const int *grausGrafo(Vertice G[]);
+int *distribuicaoGraus(Vertice G[], int ordem, int *grauMaximo);
 
 /**
  * Operacoes de busca em largura
 */
-void buscaLargura(Vertice G[], int ordem, int verticeInicial);
-bool eConexoBLargura(Vertice G[], int ordem);
-void imprimeBuscaLargura(Vertice G[], int ordem);
+ResultadoBuscaLargura *criaResultadoBuscaLargura(int ordem);
+void liberaResultadoBuscaLargura(ResultadoBuscaLargura *resultado);
+void buscaLargura(Vertice G[], int ordem, int verticeInicial, ResultadoBuscaLargura *resultado);
+bool eConexoBLargura(ResultadoBuscaLargura *resultado);
+void imprimeBuscaLargura(ResultadoBuscaLargura *resultado);
 
 /**
  * Operacoes de busca em profundidade
 */
-void buscaProfundida(Vertice G[], int ordem);
-void buscaProfundidaVisita(Vertice G[], int ordem, int verticeAtual, int *tempo, int componente);
-bool eConexoBProf(Vertice G[], int ordem);
-void imprimeBuscaProfundidade(Vertice G[], int ordem);
+ResultadoBuscaProfundidade *criaResultadoBuscaProfundidade(int ordem);
+void liberaResultadoBuscaProfundidade(ResultadoBuscaProfundidade *resultado);
+void buscaProfundida(Vertice G[], int ordem, ResultadoBuscaProfundidade *resultado);
+void buscaProfundidaVisita(Vertice G[], int ordem, int verticeAtual, int *tempo, int componente, Pilha *pilha,
+                           ResultadoBuscaProfundidade *resultado);
+bool eConexoBProf(ResultadoBuscaProfundidade *resultado);
+void imprimeBuscaProfundidade(ResultadoBuscaProfundidade *resultado);
+int numComponentes(int componente[], int ordem);
+
+/**
+ * Operacoes de conectividade por conjuntos disjuntos (union-find),
+ * atualizados por acrescentaAresta, removeAresta e aplicaAtualizacoes,
+ * sem necessidade de nova busca
+*/
+int encontraConjunto(Vertice G[], int v);
+bool mesmaComponente(Vertice G[], int ordem, int v1, int v2);
+int numComponentesConjuntos(Vertice G[]);
+bool eConexoConjuntos(Vertice G[]);
+void definirComponentesConjuntos(Vertice G[], int ordem);
+
+/**
+ * Operacoes sobre a representacao compacta (CSR) do grafo
+*/
+GrafoCSR *criaGrafoCSR(Vertice G[], int ordem);
+GrafoCSR *criaGrafoCSRArestas(int ordem, int arestas[], int numArestas);
+GrafoCSR *criaGrafoCSRParalelo(int ordem, int arestas[], int numArestas, int opcoes, int numThreads);
+void liberaGrafoCSR(GrafoCSR *csr);
+int calculaTamanhoCSR(GrafoCSR *csr);
+void imprimeGrafoCSR(GrafoCSR *csr, int componente[]);
+int gravaGrafoCSR(GrafoCSR *csr, const char *nomeArquivo);
+GrafoCSR *carregaGrafoCSR(const char *nomeArquivo);
+GrafoCSR *carregaArestasTexto(const char *nomeArquivo, int numThreads);
+void buscaLarguraCSR(GrafoCSR *csr, int verticeInicial, ResultadoBuscaLargura *resultado);
+void buscaLarguraHibridaCSR(GrafoCSR *csr, int verticeInicial, ResultadoBuscaLargura *resultado);
+void buscaLarguraParalelaCSR(GrafoCSR *csr, int verticeInicial, int numThreads, ResultadoBuscaLargura *resultado);
+void definirComponentesParaleloCSR(GrafoCSR *csr, int componente[], int numThreads);
+ResultadoBuscaMultipla *criaResultadoBuscaMultipla(int ordem, int numFontes, bool guardaDistancias);
+void liberaResultadoBuscaMultipla(ResultadoBuscaMultipla *resultado);
+void buscaLarguraMultiplaCSR(GrafoCSR *csr, int fontes[], int numFontes, int numThreads, ResultadoBuscaMultipla *resultado);
+
+/**
+ * Diametro e excentricidades a partir de poucas buscas em largura, com
+ * limites inferiores e superiores. maxBuscas limita o numero de buscas
+ * (0: sem limite, resultado exato); ao fim do limite, os valores sao
+ * limites inferiores
+*/
+int calculaDiametroCSR(GrafoCSR *csr, int maxBuscas, int *limiteSuperior);
+int calculaExcentricidadesCSR(GrafoCSR *csr, int excentricidade[], int limiteSuperior[], int maxBuscas);
+
+/**
+ * Busca em largura bidirecional, para distancia e caminho entre dois vertices.
+ * Uma mesma BuscaBidirecional nao pode ser usada por varias threads ao mesmo tempo
+*/
+BuscaBidirecional *criaBuscaBidirecional(GrafoCSR *csr);
+void liberaBuscaBidirecional(BuscaBidirecional *busca);
+int buscaLarguraBidirecionalCSR(BuscaBidirecional *busca, int u, int v, int distanciaMaxima, int caminho[]);
+
+/**
+ * Oraculo de distancias: numReferencias buscas feitas uma unica vez, e
+ * depois consultas em O(numReferencias). As consultas exatas usam o
+ * estado do oraculo, entao nao podem ser feitas por varias threads ao mesmo tempo
+*/
+OraculoDistancias *criaOraculoDistancias(GrafoCSR *csr, int numReferencias, int selecao, unsigned int semente, int numThreads);
+void liberaOraculoDistancias(OraculoDistancias *oraculo);
+int estimaDistanciaOraculo(OraculoDistancias *oraculo, int u, int v, int *limiteInferior);
+int distanciaExataOraculo(OraculoDistancias *oraculo, int u, int v);
+void buscaProfundidaCSR(GrafoCSR *csr, ResultadoBuscaProfundidade *resultado);
+void buscaProfundidaVisitaCSR(GrafoCSR *csr, int verticeAtual, int *tempo, int componente, Pilha *pilha,
+                              ResultadoBuscaProfundidade *resultado);
+
+/**
+ * Pontos de articulacao, pontes e componentes biconexas, em tempo linear
+ * e sem recursao
+*/
+ResultadoBiconexas *criaResultadoBiconexas(int ordem);
+void liberaResultadoBiconexas(ResultadoBiconexas *resultado);
+void componentesBiconexasCSR(GrafoCSR *csr, ResultadoBiconexas *resultado);
+int componenteBiconexaAresta(ResultadoBiconexas *resultado, int u, int v);
+bool ePonte(ResultadoBiconexas *resultado, int u, int v);
+void imprimeBiconexas(ResultadoBiconexas *resultado);
+
+/**
+ * Reordenacao dos vertices do grafo CSR, e traducao dos resultados
+ * obtidos sobre o grafo reordenado para os nomes originais
+*/
+Reordenacao *calculaReordenacaoCSR(GrafoCSR *csr, int metodo);
+void liberaReordenacao(Reordenacao *reordenacao);
+GrafoCSR *reordenaGrafoCSR(GrafoCSR *csr, Reordenacao *reordenacao, int numThreads);
+void traduzVetorReordenado(Reordenacao *reordenacao, int vetor[], bool valoresSaoVertices);
+void traduzResultadoBuscaLargura(Reordenacao *reordenacao, ResultadoBuscaLargura *resultado);
+void traduzResultadoBuscaProfundidade(Reordenacao *reordenacao, ResultadoBuscaProfundidade *resultado);
+
+/**
+ * Operacoes sobre o grafo comprimido. As buscas decodificam as listas
+ * de vizinhos durante o percurso, e produzem os mesmos resultados das
+ * buscas sobre o grafo CSR com as listas ordenadas
+*/
+GrafoComprimido *comprimeGrafoCSR(GrafoCSR *csr, int numThreads);
+void liberaGrafoComprimido(GrafoComprimido *comprimido);
+size_t memoriaGrafoComprimido(GrafoComprimido *comprimido);
+void buscaLarguraComprimido(GrafoComprimido *comprimido, int verticeInicial, ResultadoBuscaLargura *resultado);
+void buscaProfundidaComprimido(GrafoComprimido *comprimido, ResultadoBuscaProfundidade *resultado);
+void definirComponentesComprimido(GrafoComprimido *comprimido, int componente[], int numThreads);
+
+/**
+ * Operacoes sobre a matriz de bits, e sobre o grafo que escolhe entre
+ * ela e o CSR. As duas representacoes produzem as mesmas distancias e
+ * componentes; os pais da busca em largura podem ser outros
+*/
+GrafoDenso *criaGrafoDenso(Vertice G[], int ordem);
+GrafoDenso *criaGrafoDensoArestas(int ordem, int arestas[], int numArestas, int numThreads);
+void liberaGrafoDenso(GrafoDenso *denso);
+int calculaTamanhoDenso(GrafoDenso *denso);
+void buscaLarguraDenso(GrafoDenso *denso, int verticeInicial, ResultadoBuscaLargura *resultado);
+void definirComponentesDenso(GrafoDenso *denso, int componente[]);
+bool preferirGrafoDenso(int ordem, int numArestas);
+GrafoAutomatico *criaGrafoAutomatico(int ordem, int arestas[], int numArestas, int numThreads);
+void liberaGrafoAutomatico(GrafoAutomatico *grafo);
+int calculaTamanhoAutomatico(GrafoAutomatico *grafo);
+void buscaLarguraAutomatico(GrafoAutomatico *grafo, int verticeInicial, ResultadoBuscaLargura *resultado);
+void definirComponentesAutomatico(GrafoAutomatico *grafo, int componente[], int numThreads);
+
+/**
+ * Geradores de grafos sinteticos, para testes com grafos grandes.
+ * Produzem vetores de arestas no formato de criaGrafoCSRArestas
+ * (pares de extremos), que devem ser liberados com free.
+ * A mesma semente gera sempre o mesmo grafo, com qualquer numero de threads
+*/
+int *geraArestasRMAT(int escala, int fatorArestas, unsigned int semente, int numThreads, int *numArestas);
+int *geraArestasErdosRenyi(int ordem, int arestasSorteadas, unsigned int semente, int numThreads, int *numArestas);
+int *geraArestasGrade(int linhas, int colunas, int numThreads, int *numArestas);
+int *geraArestasCaminho(int ordem, int numThreads, int *numArestas);
+int gravaArestasTexto(int arestas[], int numArestas, const char *nomeArquivo);
+
+#ifdef INSTRUMENTACAO
+/**
+ * Operacoes sobre os contadores da instrumentacao das buscas
+*/
+void zeraContadoresBusca(void);
+void registraFronteira(int nivel, int quantidade);
+void imprimeContadoresBusca(void);
+#endif
+
+#ifdef CONTADORES_HARDWARE
+/**
+ * Operacoes sobre os contadores de hardware: abertos uma vez e
+ * ligados apenas durante o trecho medido
+*/
+bool abreContadoresHardware(ContadoresHardware *contadores);
+void comecaContadoresHardware(ContadoresHardware *contadores);
+void terminaContadoresHardware(ContadoresHardware *contadores);
+void imprimeContadoresHardware(ContadoresHardware *contadores);
+void fechaContadoresHardware(ContadoresHardware *contadores);
+#endif
 
 /**
  * Operacoes de gerenciamento da fila, usada para o gerenciamento
@@ -91,23 +732,171 @@ void enfileira(Fila *fila, int elemento);
 int desinfileira(Fila *fila);
 bool filaEstaVazia(Fila *fila);
 
+/**
+ * Operacoes de gerenciamento da pilha da busca em profundidade
+*/
+Pilha *inicializaPilha(int tamanho);
+void liberaPilha(Pilha *pilha);
+ItemPilha *empilha(Pilha *pilha, int vertice);
+ItemPilha *topoPilha(Pilha *pilha);
+void desempilha(Pilha *pilha);
+bool pilhaEstaVazia(Pilha *pilha);
+
 /*
  * Implementacao das funcoes para manipulacao de grafos 
  */
 
+/* Recupera os dados do grafo guardados antes do vetor de vertices */
+static DadosGrafo *dadosGrafo(Vertice G[])
+{
+    return (DadosGrafo *)((char *)G - offsetof(DadosGrafo, vertices));
+}
+
+/**
+ * Retira uma celula de aresta da arena do grafo. Celulas devolvidas
+ * por removeAresta sao usadas primeiro; sem elas, um novo bloco e
+ * reservado quando o atual estiver cheio
+*/
+static Aresta *novaAresta(Vertice G[])
+{
+    DadosGrafo *dados = dadosGrafo(G);
+    BlocoArestas *bloco = dados->blocos;
+    Aresta *celula = dados->livres;
+
+    if (celula != NULL)
+    {
+        dados->livres = celula->prox;
+        return celula;
+    }
+
+    if (bloco == NULL || bloco->usadas == ARESTAS_POR_BLOCO)
+    {
+        bloco = (BlocoArestas *)malloc(sizeof(BlocoArestas));
+        bloco->usadas = 0;
+        bloco->prox = dados->blocos;
+        dados->blocos = bloco;
+    }
+
+    return &bloco->celulas[bloco->usadas++];
+}
+
+/* Raiz do conjunto de um no, com a mesma divisao de caminho de encontraConjunto */
+static int raizConjunto(DadosGrafo *dados, int no)
+{
+    int *pai = dados->paiConjunto;
+    int proximo;
+
+    while (pai[no] != no)
+    {
+        proximo = pai[no];
+        pai[no] = pai[proximo];
+        no = proximo;
+    }
+
+    return no;
+}
+
+/**
+ * Une os conjuntos de v1 e v2, pendurando a raiz do menor
+ * conjunto na raiz do maior (uniao por tamanho).
+ * Retorna true se os conjuntos eram diferentes
+*/
+static bool uneConjuntos(Vertice G[], int v1, int v2)
+{
+    DadosGrafo *dados = dadosGrafo(G);
+    int r1 = encontraConjunto(G, v1);
+    int r2 = encontraConjunto(G, v2);
+    int troca;
+
+    if (r1 == r2) /* ja estao na mesma componente */
+        return false;
+
+    if (dados->tamanhoConjunto[r1] < dados->tamanhoConjunto[r2])
+    {
+        troca = r1;
+        r1 = r2;
+        r2 = troca;
+    }
+
+    dados->paiConjunto[r2] = r1;
+    dados->tamanhoConjunto[r1] += dados->tamanhoConjunto[r2];
+    dados->numConjuntos--;
+
+    return true;
+}
+
+/**
+ * Refaz os conjuntos usando apenas os nos 0..ordem-1: cada conjunto
+ * passa a ter como raiz o no do seu menor vertice, e todos os vertices
+ * apontam direto para ela. Chamada quando os nos reservados acabam
+*/
+static void compactaConjuntos(DadosGrafo *dados)
+{
+    int ordem = dados->ordem;
+    int *raiz = (int *)malloc(sizeof(int) * ordem);
+    int *tamanho = (int *)malloc(sizeof(int) * ordem);
+    int *novoNo = (int *)malloc(sizeof(int) * dados->numNos);
+    int v;
+
+    /*Primeiro so leitura: os nos antigos 0..ordem-1 serao sobrescritos*/
+    for (v = 0; v < dados->numNos; v++)
+        novoNo[v] = ELEMENTO_NAO_DEFINIDO;
+    for (v = 0; v < ordem; v++)
+    {
+        raiz[v] = raizConjunto(dados, dados->noVertice[v]);
+        if (novoNo[raiz[v]] == ELEMENTO_NAO_DEFINIDO)
+        {
+            novoNo[raiz[v]] = v;
+            tamanho[v] = dados->tamanhoConjunto[raiz[v]];
+        }
+    }
+
+    for (v = 0; v < ordem; v++)
+    {
+        dados->noVertice[v] = v;
+        dados->paiConjunto[v] = novoNo[raiz[v]];
+        if (novoNo[raiz[v]] == v)
+            dados->tamanhoConjunto[v] = tamanho[v];
+    }
+    dados->numNos = ordem;
+
+    free(raiz);
+    free(tamanho);
+    free(novoNo);
+}
+
 /* Criacao de um grafo com ordem predefinida e, inicilamente, sem nenhuma aresta */
 void criaGrafo(Vertice **G, int ordem)
 {
     int i;
-    *G = (Vertice *)malloc(sizeof(Vertice) * ordem); /* Alocacao dinamica de um vetor de vertices */
+    DadosGrafo *dados;
+
+    /* Alocacao dinamica dos dados do grafo junto do vetor de vertices */
+    dados = (DadosGrafo *)malloc(sizeof(DadosGrafo) + sizeof(Vertice) * (ordem > 0 ? ordem - 1 : 0));
+    dados->blocos = NULL;
+    dados->livres = NULL;
+    dados->remocao = NULL;
+    dados->ordem = ordem;
+    *G = dados->vertices;
+
+    /* Cada vertice comeca sozinho em seu conjunto, com o no de mesmo numero */
+    dados->grau = (int *)calloc(ordem > 0 ? ordem : 1, sizeof(int));
+    dados->numArestas = 0;
+
+    dados->noVertice = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    dados->paiConjunto = (int *)malloc(sizeof(int) * (ordem > 0 ? 2 * ordem : 1));
+    dados->tamanhoConjunto = (int *)malloc(sizeof(int) * (ordem > 0 ? 2 * ordem : 1));
+    dados->numNos = ordem;
+    dados->numConjuntos = ordem;
 
     for (i = 0; i < ordem; i++)
     {
         (*G)[i].nome = i;
-        (*G)[i].componente = ELEMENTO_NAO_DEFINIDO;         /* -1: sem componente atribuida */
-        (*G)[i].prim = NULL;                                /* Cada vertice sem nenhuma aresta incidente */
-        (*G)[i].paiBuscaLargura = ELEMENTO_NAO_DEFINIDO;    /* Não possui pai antes da busca em largura ser executada */
-        (*G)[i].paiBuscaProfundida = ELEMENTO_NAO_DEFINIDO; /* Não possui pai antes da busca em profundida ser executada */
+        (*G)[i].componente = ELEMENTO_NAO_DEFINIDO; /* -1: sem componente atribuida */
+        (*G)[i].prim = NULL;                        /* Cada vertice sem nenhuma aresta incidente */
+        dados->noVertice[i] = i;
+        dados->paiConjunto[i] = i;
+        dados->tamanhoConjunto[i] = 1;
     }
 }
 
@@ -117,6 +906,7 @@ void criaGrafo(Vertice **G, int ordem)
 */
 int acrescentaAresta(Vertice G[], int ordem, int v1, int v2)
 {
+    DadosGrafo *dados;
     Aresta *A1;
     Aresta *A2;
 
@@ -126,53 +916,323 @@ int acrescentaAresta(Vertice G[], int ordem, int v1, int v2)
         return 0;
 
     /* Acrescento aresta na lista do vertice v1 */
-    A1 = (Aresta *)malloc(sizeof(Aresta));
+    A1 = novaAresta(G);
     A1->nome = v2;
     A1->prox = G[v1].prim;
     G[v1].prim = A1;
 
     /* Acrescento aresta na lista do vertice v2 */
-    A2 = (Aresta *)malloc(sizeof(Aresta));
+    A2 = novaAresta(G);
     A2->nome = v1;
     A2->prox = G[v2].prim;
     G[v2].prim = A2;
 
+    dados = dadosGrafo(G);
+    dados->grau[v1]++;
+    dados->grau[v2]++;
+    dados->numArestas++;
+
+    /* Os extremos passam a estar na mesma componente. Se estavam em
+       componentes diferentes, a aresta entra na floresta geradora */
+    A1->floresta = A2->floresta = uneConjuntos(G, v1, v2);
+
     return 1;
 }
 
-/*  Funcao que retorna o tamanho de um grafo */
-int calculaTamanho(Vertice G[], int ordem)
+/**
+ * Retira da lista de v uma celula que leva a w e a devolve para
+ * a lista de livres. Com floresta >= 0, so serve uma celula com
+ * essa marca. Retorna a marca da celula retirada, ou -1 se nenhuma serve
+*/
+static int retiraCelula(Vertice G[], int v, int w, int floresta)
 {
-    int i;
-    int totalArestas = 0;
+    DadosGrafo *dados = dadosGrafo(G);
+    Aresta **referencia = &G[v].prim;
+    Aresta *celula;
 
-    for (i = 0; i < ordem; i++)
+    for (celula = *referencia; celula != NULL; referencia = &celula->prox, celula = *referencia)
     {
-        int j;
-        Aresta *aux = G[i].prim;
-        for (j = 0; aux != NULL; aux = aux->prox, j++)
-            ;
-        totalArestas += j;
+        if (celula->nome == w && (floresta < 0 || celula->floresta == floresta))
+        {
+            *referencia = celula->prox;
+            celula->prox = dados->livres;
+            dados->livres = celula;
+            return celula->floresta;
+        }
     }
-    return totalArestas / 2 + ordem;
+
+    return -1;
 }
-/**
- * Imprime um grafo exibindo seus vertices e as arestas incidentes neles
-*/
-void imprimeGrafo(Vertice G[], int ordem)
+
+/* Vetores de apoio da busca por substituta, reservados na primeira vez */
+static ApoioRemocao *apoioRemocao(DadosGrafo *dados)
 {
-    int i;
-    Aresta *aux;
+    ApoioRemocao *apoio = dados->remocao;
+    int i, ordem = dados->ordem;
 
-    printf("Ordem:       %d\n", ordem);
-    printf("Tamanho:     %d\n", calculaTamanho(G, ordem));
-    printf("===Lista de Adjacencia===:\n");
+    if (apoio != NULL)
+        return apoio;
 
+    apoio = (ApoioRemocao *)malloc(sizeof(ApoioRemocao));
+    apoio->marca = (int *)malloc(sizeof(int) * ordem);
+    apoio->epoca = 0;
+    for (i = 0; i < 2; i++)
+        apoio->alcancados[i] = (int *)malloc(sizeof(int) * ordem);
+    apoio->cursor = (Aresta **)malloc(sizeof(Aresta *) * ordem);
     for (i = 0; i < ordem; i++)
-    {
-        printf("V%d (Comp:%2d): ", i, G[i].componente);
-        aux = G[i].prim;
-        for (; aux != NULL; aux = aux->prox)
+        apoio->marca[i] = ELEMENTO_NAO_DEFINIDO;
+
+    dados->remocao = apoio;
+    return apoio;
+}
+
+/* Poe na floresta a celula de x e a outra metade dela, na lista do vizinho */
+static void promoveSubstituta(Vertice G[], Aresta *celula, int x)
+{
+    celula->floresta = 1;
+    for (celula = G[celula->nome].prim; celula->nome != x || celula->floresta; celula = celula->prox)
+        ;
+    celula->floresta = 1;
+}
+
+/**
+ * Trata a remocao da aresta u-v da floresta geradora. As arvores de u
+ * e de v, agora separadas, sao percorridas em largura pelas arestas da
+ * floresta ao mesmo tempo, uma celula de cada lado por vez, ate que uma
+ * aresta fora da floresta ligue as duas ou que uma delas termine. Nesse
+ * caso so a menor arvore e examinada em busca de uma aresta que leve
+ * para fora dela (substituta). Havendo substituta, ela entra na floresta
+ * e a componente continua a mesma; senao, a menor arvore vira um conjunto
+ * novo. O custo fica limitado pela soma dos graus da menor arvore, e nao
+ * pelo tamanho da componente
+*/
+static void reconectaFloresta(Vertice G[], int u, int v)
+{
+    DadosGrafo *dados = dadosGrafo(G);
+    ApoioRemocao *apoio = apoioRemocao(dados);
+    int *marca = apoio->marca;
+    int inicio[2], numAlcancados[2];
+    int base, lado, menor, i, x, y, antigo, novo;
+    Aresta *celula;
+
+    /*Uma epoca nova a cada busca: as marcas antigas ficam abaixo da base*/
+    if (apoio->epoca >= INT_MAX / 2 - 1)
+    {
+        for (i = 0; i < dados->ordem; i++)
+            marca[i] = ELEMENTO_NAO_DEFINIDO;
+        apoio->epoca = 0;
+    }
+    base = 2 * apoio->epoca++;
+
+    for (lado = 0; lado < 2; lado++)
+    {
+        x = lado == 0 ? u : v;
+        marca[x] = base + lado;
+        apoio->cursor[x] = G[x].prim;
+        apoio->alcancados[lado][0] = x;
+        inicio[lado] = 0;
+        numAlcancados[lado] = 1;
+    }
+
+    /*Busca em largura alternada nas duas arvores, a partir dos extremos*/
+    for (lado = 0; inicio[lado] < numAlcancados[lado]; lado = 1 - lado)
+    {
+        x = apoio->alcancados[lado][inicio[lado]];
+        celula = apoio->cursor[x];
+        if (celula == NULL)
+        {
+            inicio[lado]++;
+            continue;
+        }
+
+        apoio->cursor[x] = celula->prox;
+        y = celula->nome;
+        if (celula->floresta && marca[y] != base + lado)
+        {
+            marca[y] = base + lado;
+            apoio->cursor[y] = G[y].prim;
+            apoio->alcancados[lado][numAlcancados[lado]++] = y;
+        }
+        else if (!celula->floresta && marca[y] == base + 1 - lado)
+        {
+            /*Aresta entre as duas arvores: substituta encontrada antes do fim*/
+            promoveSubstituta(G, celula, x);
+            return;
+        }
+    }
+    menor = lado;
+
+    /*Procura uma substituta saindo da menor arvore*/
+    for (i = 0; i < numAlcancados[menor]; i++)
+    {
+        x = apoio->alcancados[menor][i];
+        for (celula = G[x].prim; celula != NULL; celula = celula->prox)
+        {
+            if (!celula->floresta && marca[celula->nome] != base + menor)
+            {
+                promoveSubstituta(G, celula, x);
+                return;
+            }
+        }
+    }
+
+    /*Sem substituta: a menor arvore e uma componente inteira e ganha um no novo*/
+    if (dados->numNos == 2 * dados->ordem)
+        compactaConjuntos(dados);
+
+    antigo = encontraConjunto(G, apoio->alcancados[menor][0]);
+    novo = dados->numNos++;
+    dados->paiConjunto[novo] = novo;
+    dados->tamanhoConjunto[novo] = numAlcancados[menor];
+    dados->tamanhoConjunto[antigo] -= numAlcancados[menor];
+    dados->numConjuntos++;
+
+    for (i = 0; i < numAlcancados[menor]; i++)
+        dados->noVertice[apoio->alcancados[menor][i]] = novo;
+}
+
+/**
+ * Remove uma aresta v1-v2 do grafo. Havendo arestas repetidas, apenas
+ * uma e removida. Os conjuntos continuam corretos sem nova busca no grafo
+ * todo: so a remocao de uma aresta da floresta geradora exige procurar
+ * uma substituta (veja reconectaFloresta).
+ * Retorna 0 se os vertices sao invalidos ou a aresta nao existe
+*/
+int removeAresta(Vertice G[], int ordem, int v1, int v2)
+{
+    DadosGrafo *dados;
+    int floresta;
+
+    if (v1 < 0 || v1 >= ordem) /* Testo se vertices sao validos */
+        return 0;
+    if (v2 < 0 || v2 >= ordem)
+        return 0;
+
+    floresta = retiraCelula(G, v1, v2, -1);
+    if (floresta < 0)
+        return 0;
+    retiraCelula(G, v2, v1, floresta); /* a outra metade, com a mesma marca */
+
+    dados = dadosGrafo(G);
+    dados->grau[v1]--;
+    dados->grau[v2]--;
+    dados->numArestas--;
+
+    if (floresta)
+        reconectaFloresta(G, v1, v2);
+
+    return 1;
+}
+
+/**
+ * Aplica um lote de atualizacoes, na ordem do vetor. Cada uma tem o
+ * mesmo efeito da chamada isolada de acrescentaAresta ou removeAresta,
+ * e os vetores de apoio das remocoes sao reservados uma unica vez.
+ * Retorna o numero de atualizacoes efetivamente aplicadas
+*/
+int aplicaAtualizacoes(Vertice G[], int ordem, AtualizacaoAresta atualizacoes[], int numAtualizacoes)
+{
+    int i, aplicadas = 0;
+
+    for (i = 0; i < numAtualizacoes; i++)
+    {
+        if (atualizacoes[i].operacao == ATUALIZACAO_ACRESCENTA)
+            aplicadas += acrescentaAresta(G, ordem, atualizacoes[i].v1, atualizacoes[i].v2);
+        else if (atualizacoes[i].operacao == ATUALIZACAO_REMOVE)
+            aplicadas += removeAresta(G, ordem, atualizacoes[i].v1, atualizacoes[i].v2);
+    }
+
+    return aplicadas;
+}
+
+/**
+ * Libera um grafo criado por criaGrafo: todos os blocos de arestas
+ * e o vetor de vertices. Nao percorre as listas de adjacencia
+*/
+void liberaGrafo(Vertice G[])
+{
+    DadosGrafo *dados = dadosGrafo(G);
+    BlocoArestas *bloco, *anterior;
+    int i;
+
+    for (bloco = dados->blocos; bloco != NULL; bloco = anterior)
+    {
+        anterior = bloco->prox;
+        free(bloco);
+    }
+
+    if (dados->remocao != NULL)
+    {
+        free(dados->remocao->marca);
+        for (i = 0; i < 2; i++)
+            free(dados->remocao->alcancados[i]);
+        free(dados->remocao->cursor);
+        free(dados->remocao);
+    }
+
+    free(dados->grau);
+    free(dados->noVertice);
+    free(dados->paiConjunto);
+    free(dados->tamanhoConjunto);
+    free(dados);
+}
+
+/*  Funcao que retorna o tamanho de um grafo: ordem mais o numero de arestas, mantido pelo grafo */
+int calculaTamanho(Vertice G[], int ordem)
+{
+    return dadosGrafo(G)->numArestas + ordem;
+}
+
+/**
+ * Grau de cada vertice, mantido por acrescentaAresta e removeAresta.
+ * O vetor pertence ao grafo e nao deve ser alterado nem liberado
+*/
+const int *grausGrafo(Vertice G[])
+{
+    return dadosGrafo(G)->grau;
+}
+
+/**
+ * Distribuicao dos graus: a posicao d do vetor devolvido guarda quantos
+ * vertices tem grau d, de 0 ate o grau maximo, devolvido em grauMaximo.
+ * Uma passada pelo vetor de graus, sem percorrer as listas.
+ * O vetor devolvido deve ser liberado com free
+*/
+int *distribuicaoGraus(Vertice G[], int ordem, int *grauMaximo)
+{
+    const int *grau = grausGrafo(G);
+    int *histograma;
+    int i, maximo = 0;
+
+    for (i = 0; i < ordem; i++)
+        if (grau[i] > maximo)
+            maximo = grau[i];
+
+    histograma = (int *)calloc(maximo + 1, sizeof(int));
+    for (i = 0; i < ordem; i++)
+        histograma[grau[i]]++;
+
+    *grauMaximo = maximo;
+    return histograma;
+}
+
+/**
+ * Imprime um grafo exibindo seus vertices e as arestas incidentes neles
+*/
+void imprimeGrafo(Vertice G[], int ordem)
+{
+    int i;
+    Aresta *aux;
+
+    printf("Ordem:       %d\n", ordem);
+    printf("Tamanho:     %d\n", calculaTamanho(G, ordem));
+    printf("===Lista de Adjacencia===:\n");
+
+    for (i = 0; i < ordem; i++)
+    {
+        printf("V%d (Comp:%2d): ", i, G[i].componente);
+        aux = G[i].prim;
+        for (; aux != NULL; aux = aux->prox)
             printf("%3d", aux->nome);
 
         printf("\n");
@@ -180,430 +1240,5233 @@ void imprimeGrafo(Vertice G[], int ordem)
     printf("=========================:\n\n");
 }
 
-void imprimeBuscaLargura(Vertice G[], int ordem)
+void imprimeBuscaLargura(ResultadoBuscaLargura *resultado)
 {
     int i, indiceCor, indicePai;
     bool conexoBuscaLargura;
     const char *cores[3] = {"Branco", "Cinza", "Preto"};
 
-    conexoBuscaLargura = eConexoBLargura(G, ordem);
+    conexoBuscaLargura = eConexoBLargura(resultado);
 
     printf("====Busca em Largura ====:\n");
     printf("Conexo busca em largura: %s\n", conexoBuscaLargura ? "sim" : "nao");
-    for (i = 0; i < ordem; i++)
+    for (i = 0; i < resultado->ordem; i++)
     {
-        indiceCor = G[i].corBuscaLargura - 1;
-        indicePai = G[i].paiBuscaLargura;
+        indiceCor = (TESTA_BIT(resultado->visitados, i) ? PRETO : BRANCO) - 1;
+        indicePai = resultado->pai[i];
 
         if (indicePai == ELEMENTO_NAO_DEFINIDO)
-            printf("V%d (não tem) (cor: %s) (distância: %d)\n", i, cores[indiceCor], G[i].distanciaBuscaLargura);
+            printf("V%d (não tem) (cor: %s) (distância: %d)\n", i, cores[indiceCor], resultado->distancia[i]);
 
         else
-            printf("V%d (pai: V%d) (cor: %s) (distância: %d)\n", i, indicePai, cores[indiceCor], G[i].distanciaBuscaLargura);
+            printf("V%d (pai: V%d) (cor: %s) (distância: %d)\n", i, indicePai, cores[indiceCor], resultado->distancia[i]);
     }
     printf("=========================:\n\n");
 }
 
-void imprimeBuscaProfundidade(Vertice G[], int ordem)
+void imprimeBuscaProfundidade(ResultadoBuscaProfundidade *resultado)
 {
     int i, indiceCor, indicePai, tDescoberta, tFinal;
     bool conexoBuscaProf;
     const char *cores[3] = {"Branco", "Cinza", "Preto"};
 
-    conexoBuscaProf = eConexoBProf(G, ordem);
+    conexoBuscaProf = eConexoBProf(resultado);
 
     printf("==Busca em Profundidade==:\n");
     printf("Conexo busca em profundidade: %s\n", conexoBuscaProf ? "sim" : "nao");
-    for (i = 0; i < ordem; i++)
+    for (i = 0; i < resultado->ordem; i++)
+    {
+        indiceCor = (TESTA_BIT(resultado->visitados, i) ? PRETO : BRANCO) - 1;
+        indicePai = resultado->pai[i];
+        tDescoberta = resultado->tempoDescoberta[i];
+        tFinal = resultado->tempoFinalizacao[i];
+
+        if (indicePai == ELEMENTO_NAO_DEFINIDO)
+            printf("V%d (não tem) (cor:%s) (tempo de descoberta: %d), (tempo de Finalização: %d)\n", i, cores[indiceCor], tDescoberta, tFinal);
+
+        else
+            printf("V%d (pai: V%d) (cor:%s) (tempo de descoberta: %d), (tempo de Finalização: %d)\n", i, indicePai, cores[indiceCor], tDescoberta, tFinal);
+    }
+    printf("=========================:\n\n");
+}
+
+/**
+ * Inicializacao dos valores da fila, 
+ * retorno do ponteiro para a fila inicializada
+*/
+Fila *inicializaFila(int tamanho)
+{
+    Fila *fila = (Fila *)malloc(sizeof(Fila));
+
+    fila->indiceRetirada = 0; /*indice a ser usado quando retirando primeiro elemento*/
+    fila->indiceInsercao = 0; /*indice a ser usado quando inserindo primeiro elemento*/
+    fila->tamanhoMax = tamanho;
+    fila->valores = (int *)calloc(tamanho, sizeof(int)); /*todos os elementos da fila igual a zero*/
+
+    return fila;
+}
+
+/**
+ * Adicao de elemento na fila. Considerando a estrutura de dados,
+ * FIFO, vai ser o último a sair considerando todos os elementos 
+ * que foram enfileirados anteriormente
+*/
+void enfileira(Fila *fila, int elemento)
+{
+    /*validando se fila atingiu seu limite*/
+    if (fila->indiceInsercao >= fila->tamanhoMax)
+    {
+        printf("Fila atingiu sua capacidade máxima: %d", fila->tamanhoMax);
+        return;
+    }
+
+    fila->valores[fila->indiceInsercao] = elemento;
+    fila->indiceInsercao++;
+    CONTA_ENFILEIRAMENTOS(1);
+}
+
+int desinfileira(Fila *fila)
+{
+    int elementoRetirado;
+
+    /*validando se estamos desinfileirando antes do elemento ser inserido*/
+    if (fila->indiceInsercao < fila->indiceRetirada)
+    {
+        printf("Fazendo retirada da fila antes de adicionar elemento. %d - %d", fila->indiceInsercao, fila->indiceRetirada);
+        return ELEMENTO_NAO_DEFINIDO;
+    }
+
+    elementoRetirado = fila->valores[fila->indiceRetirada];
+    fila->indiceRetirada++;
+
+    return elementoRetirado;
+}
+
+/**
+ * Funcao de utilidade para checar se a fila 
+ * passada como parametro esta vazia ou nao.
+ * No algoritmo de busca em profundida, 
+ * usada como condicao de parada
+*/
+bool filaEstaVazia(Fila *fila)
+{
+    return fila->indiceRetirada >= fila->indiceInsercao;
+}
+
+/**
+ * Funcao de utilidade para a liberação dos elementos da fila da memoria
+*/
+void liberaFila(Fila *fila)
+{
+    free(fila->valores);
+    free(fila);
+}
+
+/**
+ * Inicializacao de uma pilha vazia, com espaco para tamanho itens.
+ * Reservada uma unica vez por busca e reaproveitada por todas as visitas
+*/
+Pilha *inicializaPilha(int tamanho)
+{
+    Pilha *pilha = (Pilha *)malloc(sizeof(Pilha));
+
+    pilha->topo = 0;
+    pilha->tamanhoMax = tamanho;
+    pilha->itens = (ItemPilha *)malloc(sizeof(ItemPilha) * (tamanho > 0 ? tamanho : 1));
+
+    return pilha;
+}
+
+/**
+ * Coloca um vertice no topo da pilha e devolve o item criado,
+ * para que quem empilhou defina o proximo vizinho a ser examinado
+*/
+ItemPilha *empilha(Pilha *pilha, int vertice)
+{
+    ItemPilha *item;
+
+    /*validando se pilha atingiu seu limite*/
+    if (pilha->topo >= pilha->tamanhoMax)
+    {
+        printf("Pilha atingiu sua capacidade máxima: %d", pilha->tamanhoMax);
+        return NULL;
+    }
+
+    item = &pilha->itens[pilha->topo++];
+    item->vertice = vertice;
+    REGISTRA_PROFUNDIDADE(pilha->topo);
+    return item;
+}
+
+ItemPilha *topoPilha(Pilha *pilha)
+{
+    return &pilha->itens[pilha->topo - 1];
+}
+
+void desempilha(Pilha *pilha)
+{
+    pilha->topo--;
+}
+
+bool pilhaEstaVazia(Pilha *pilha)
+{
+    return pilha->topo == 0;
+}
+
+void liberaPilha(Pilha *pilha)
+{
+    free(pilha->itens);
+    free(pilha);
+}
+
+/*
+ * Implementacao da instrumentacao das buscas
+ */
+
+#ifdef INSTRUMENTACAO
+/* O vetor de tamanhos de fronteira e mantido entre buscas, apenas esvaziado */
+void zeraContadoresBusca(void)
+{
+    contadoresBusca.arestasExaminadas = 0;
+    contadoresBusca.enfileiramentos = 0;
+    contadoresBusca.profundidadeMaxima = 0;
+    contadoresBusca.niveis = 0;
+}
+
+/* Soma quantidade vertices a fronteira do nivel dado */
+void registraFronteira(int nivel, int quantidade)
+{
+    int i;
+
+    if (nivel >= contadoresBusca.capacidadeNiveis)
+    {
+        i = contadoresBusca.capacidadeNiveis;
+        contadoresBusca.capacidadeNiveis = 2 * nivel + 16;
+        contadoresBusca.tamanhoFronteira = (int *)realloc(contadoresBusca.tamanhoFronteira,
+                                                          sizeof(int) * contadoresBusca.capacidadeNiveis);
+        for (; i < contadoresBusca.capacidadeNiveis; i++)
+            contadoresBusca.tamanhoFronteira[i] = 0;
+    }
+
+    for (; contadoresBusca.niveis <= nivel; contadoresBusca.niveis++)
+        contadoresBusca.tamanhoFronteira[contadoresBusca.niveis] = 0;
+    contadoresBusca.tamanhoFronteira[nivel] += quantidade;
+}
+
+void imprimeContadoresBusca(void)
+{
+    int i, maiorFronteira;
+
+    maiorFronteira = 0;
+    for (i = 0; i < contadoresBusca.niveis; i++)
+        if (contadoresBusca.tamanhoFronteira[i] > maiorFronteira)
+            maiorFronteira = contadoresBusca.tamanhoFronteira[i];
+
+    printf("Arestas examinadas:     %lu\n", contadoresBusca.arestasExaminadas);
+    printf("Vertices enfileirados:  %lu\n", contadoresBusca.enfileiramentos);
+    if (contadoresBusca.niveis > 0)
+    {
+        printf("Niveis:                 %d (maior fronteira: %d)\n", contadoresBusca.niveis, maiorFronteira);
+        printf("Fronteira por nivel:   ");
+        for (i = 0; i < contadoresBusca.niveis; i++)
+            printf(" %d", contadoresBusca.tamanhoFronteira[i]);
+        printf("\n");
+    }
+    if (contadoresBusca.profundidadeMaxima > 0)
+        printf("Profundidade maxima:    %d\n", contadoresBusca.profundidadeMaxima);
+}
+#endif
+
+#ifdef CONTADORES_HARDWARE
+static const char *nomesEventosHardware[NUM_EVENTOS_HARDWARE] = {
+    "Instrucoes", "Ciclos", "Acessos a cache", "Faltas na cache"};
+
+static const unsigned long eventosHardware[NUM_EVENTOS_HARDWARE] = {
+    PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+
+/**
+ * Abre os contadores de hardware da thread atual, desligados e em grupo,
+ * para serem ligados e desligados juntos. Apenas o codigo do usuario
+ * e contado. Retorna false se nenhum contador estiver disponivel
+ * (sem suporte do processador, em maquinas virtuais ou por permissao)
+*/
+bool abreContadoresHardware(ContadoresHardware *contadores)
+{
+    struct perf_event_attr atributos;
+    int i, lider;
+
+    lider = -1;
+    for (i = 0; i < NUM_EVENTOS_HARDWARE; i++)
     {
-        indiceCor = G[i].corBuscaProfundida - 1;
-        indicePai = G[i].paiBuscaProfundida;
-        tDescoberta = G[i].tempoDescobertaBuscaProf;
-        tFinal = G[i].tempoFinalizacaoBuscaProf;
+        memset(&atributos, 0, sizeof(atributos));
+        atributos.type = PERF_TYPE_HARDWARE;
+        atributos.size = sizeof(atributos);
+        atributos.config = eventosHardware[i];
+        atributos.disabled = lider < 0;
+        atributos.exclude_kernel = 1;
+        atributos.exclude_hv = 1;
+
+        contadores->descritores[i] = (int)syscall(__NR_perf_event_open, &atributos, 0, -1, lider, 0);
+        contadores->valores[i] = 0;
+        if (lider < 0 && contadores->descritores[i] >= 0)
+            lider = contadores->descritores[i];
+    }
+
+    return lider >= 0;
+}
+
+static int liderContadoresHardware(ContadoresHardware *contadores)
+{
+    int i;
+
+    for (i = 0; i < NUM_EVENTOS_HARDWARE; i++)
+        if (contadores->descritores[i] >= 0)
+            return contadores->descritores[i];
+    return -1;
+}
+
+void comecaContadoresHardware(ContadoresHardware *contadores)
+{
+    int lider = liderContadoresHardware(contadores);
+
+    if (lider < 0)
+        return;
+    ioctl(lider, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(lider, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void terminaContadoresHardware(ContadoresHardware *contadores)
+{
+    int lider = liderContadoresHardware(contadores);
+    int i;
+
+    if (lider < 0)
+        return;
+    ioctl(lider, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    for (i = 0; i < NUM_EVENTOS_HARDWARE; i++)
+        if (contadores->descritores[i] < 0 ||
+            read(contadores->descritores[i], &contadores->valores[i], sizeof(uint64_t)) != sizeof(uint64_t))
+            contadores->valores[i] = 0;
+}
+
+void imprimeContadoresHardware(ContadoresHardware *contadores)
+{
+    int i;
+
+    for (i = 0; i < NUM_EVENTOS_HARDWARE; i++)
+    {
+        if (contadores->descritores[i] < 0)
+            printf("%-22s  indisponivel\n", nomesEventosHardware[i]);
+        else
+            printf("%-22s  %lu\n", nomesEventosHardware[i], (unsigned long)contadores->valores[i]);
+    }
+}
+
+void fechaContadoresHardware(ContadoresHardware *contadores)
+{
+    int i;
+
+    for (i = 0; i < NUM_EVENTOS_HARDWARE; i++)
+        if (contadores->descritores[i] >= 0)
+            close(contadores->descritores[i]);
+}
+#endif
+
+/**
+ * Reserva os vetores do resultado de uma busca em largura. O mesmo
+ * resultado pode ser reaproveitado por varias buscas no mesmo grafo
+*/
+ResultadoBuscaLargura *criaResultadoBuscaLargura(int ordem)
+{
+    ResultadoBuscaLargura *resultado = (ResultadoBuscaLargura *)malloc(sizeof(ResultadoBuscaLargura));
+
+    resultado->ordem = ordem;
+    resultado->pai = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    resultado->distancia = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    resultado->visitados = (PalavraBits *)malloc(sizeof(PalavraBits) * (PALAVRAS_MAPA_BITS(ordem) + 1));
+
+    return resultado;
+}
+
+void liberaResultadoBuscaLargura(ResultadoBuscaLargura *resultado)
+{
+    free(resultado->pai);
+    free(resultado->distancia);
+    free(resultado->visitados);
+    free(resultado);
+}
+
+/**
+ * inicializacao do algoritmo:
+ * todos os vertices brancos, distancia inicial inicializada e pai como nulo
+*/
+static void iniciaResultadoBuscaLargura(ResultadoBuscaLargura *resultado)
+{
+    int i;
+
+    for (i = 0; i < resultado->ordem; i++)
+    {
+        resultado->distancia[i] = INT_MAX;
+        resultado->pai[i] = ELEMENTO_NAO_DEFINIDO;
+    }
+    memset(resultado->visitados, 0, sizeof(PalavraBits) * PALAVRAS_MAPA_BITS(resultado->ordem));
+    ZERA_CONTADORES(); /* todas as buscas comecam por aqui */
+}
+
+void buscaLargura(Vertice G[], int ordem, int verticeInicial, ResultadoBuscaLargura *resultado)
+{
+    Fila *Q;
+    Aresta *aux;
+    int *distancia = resultado->distancia;
+    int *pai = resultado->pai;
+    PalavraBits *visitados = resultado->visitados;
+
+    iniciaResultadoBuscaLargura(resultado);
+
+    if (verticeInicial < 0 || verticeInicial >= ordem) /* Testo se vertice e valido */
+        return;
+
+    /*
+    verticie inicial:
+    visitado, distancia zero (por ser ele mesmo) 
+    e sem pais na arvore de busca*/
+    MARCA_BIT(visitados, verticeInicial);
+    distancia[verticeInicial] = 0;
+    REGISTRA_FRONTEIRA(0, 1);
+
+    Q = inicializaFila(ordem); /*Fila vazia, para ser usar, no maximo, ordem vezes*/
+    enfileira(Q, verticeInicial);
+
+    while (!filaEstaVazia(Q))
+    {
+        int u = desinfileira(Q);
+
+        /*Iterando sobre as arestas do vertice atual, e fazendo a busca por eles*/
+        for (aux = G[u].prim; aux != NULL; aux = aux->prox)
+        {
+            int v = aux->nome;
+            CONTA_ARESTAS(1);
+            if (!TESTA_BIT(visitados, v))
+            {
+                MARCA_BIT(visitados, v);
+                distancia[v] = distancia[u] + 1;
+                pai[v] = u;
+                REGISTRA_FRONTEIRA(distancia[v], 1);
+
+                enfileira(Q, v);
+            }
+        }
+    }
+
+    liberaFila(Q);
+}
+
+/**
+ * A gente vai dizer que um grafo e conexo a partir da
+ * realizacao da busca em profundida se todos os vertices
+ * do grafo estiverem pintados de preto
+ * 
+ * O metodo atual conta a quantidade de vertices de cada cor,
+ * imprime o resultado e retorna verdadeiro se, e apenas se, 
+ * todos os vertices forem pretos
+*/
+bool eConexoBLargura(ResultadoBuscaLargura *resultado)
+{
+    int pretos, i;
+    pretos = 0;
+
+    /*Contando quantos vertices pretos (visitados) tem no grafo*/
+    for (i = 0; i < resultado->ordem; i++)
+        if (TESTA_BIT(resultado->visitados, i))
+            pretos++;
+
+    return pretos == resultado->ordem;
+}
+
+/**
+ * Comeco da visita de um vertice: documentar o tempo de 
+ * inicio, marcar ele como visitado e marcar sua componente
+*/
+static void descobreVertice(ResultadoBuscaProfundidade *resultado, int u, int *tempo, int componente)
+{
+    (*tempo)++;
+    resultado->tempoDescoberta[u] = *tempo;
+    MARCA_BIT(resultado->visitados, u);
+    resultado->componente[u] = componente; /*usado na verificacao de conexidade*/
+}
+
+/**
+ * Fim da visita de um vertice: todos os seus adjacentes ja foram
+ * visitados, e ele recebe seu tempo de finalizacao
+*/
+static void finalizaVertice(ResultadoBuscaProfundidade *resultado, int u, int *tempo)
+{
+    (*tempo)++;
+    resultado->tempoFinalizacao[u] = *tempo;
+}
+
+/**
+ * Reserva os vetores do resultado de uma busca em profundidade,
+ * que pode ser reaproveitado por varias buscas no mesmo grafo
+*/
+ResultadoBuscaProfundidade *criaResultadoBuscaProfundidade(int ordem)
+{
+    ResultadoBuscaProfundidade *resultado = (ResultadoBuscaProfundidade *)malloc(sizeof(ResultadoBuscaProfundidade));
+    int tamanho = ordem > 0 ? ordem : 1;
+
+    resultado->ordem = ordem;
+    resultado->pai = (int *)malloc(sizeof(int) * tamanho);
+    resultado->tempoDescoberta = (int *)malloc(sizeof(int) * tamanho);
+    resultado->tempoFinalizacao = (int *)malloc(sizeof(int) * tamanho);
+    resultado->componente = (int *)malloc(sizeof(int) * tamanho);
+    resultado->visitados = (PalavraBits *)malloc(sizeof(PalavraBits) * (PALAVRAS_MAPA_BITS(ordem) + 1));
+
+    return resultado;
+}
+
+void liberaResultadoBuscaProfundidade(ResultadoBuscaProfundidade *resultado)
+{
+    free(resultado->pai);
+    free(resultado->tempoDescoberta);
+    free(resultado->tempoFinalizacao);
+    free(resultado->componente);
+    free(resultado->visitados);
+    free(resultado);
+}
+
+/*Inicializacao de valores dos vertices para a realizacao do algoritmo*/
+static void iniciaResultadoBuscaProfundidade(ResultadoBuscaProfundidade *resultado)
+{
+    int i;
+
+    for (i = 0; i < resultado->ordem; i++)
+    {
+        resultado->pai[i] = ELEMENTO_NAO_DEFINIDO;
+        resultado->componente[i] = ELEMENTO_NAO_DEFINIDO;
+    }
+    memset(resultado->visitados, 0, sizeof(PalavraBits) * PALAVRAS_MAPA_BITS(resultado->ordem));
+    ZERA_CONTADORES();
+}
+
+/**
+ * Aqui, para conseguirmos definir a partir do presente
+ * algoritmo se um grafo e conexo ou nao, precisamos 
+ * passar para a funcao de visita o componente
+*/
+void buscaProfundida(Vertice G[], int ordem, ResultadoBuscaProfundidade *resultado)
+{
+    Pilha *pilha;
+    int tempo;
+    int j;
+
+    iniciaResultadoBuscaProfundidade(resultado);
+
+    /*Uma unica pilha, reaproveitada pela visita de cada componente*/
+    pilha = inicializaPilha(ordem);
+
+    /*tempo: variavel informativa, para determinar em que momentos os vertices foram explorados*/
+    tempo = 0;
+    for (j = 0; j < ordem; j++)
+    {
+        if (!TESTA_BIT(resultado->visitados, j))
+            /*Somente o indice 0 vai ser usado se o grafo for conexo*/
+            buscaProfundidaVisita(G, ordem, j, &tempo, j, pilha, resultado);
+    }
+
+    liberaPilha(pilha);
+}
+
+/**
+ * Função usada para navegar entre os vértices do grafo a partir de verticeAtual.
+ * Recebe como parametro um ponteiro de tempo, que vai ser usado para
+ * documentar o momento em que o vertice foi 'descoberto' e 'finalizado'.
+ * Recebe tambem a componente do vertice sendo visitado. Isso nos permite, 
+ * a partir da funcao base de buscaProfundida, decidir se o grafo e conexo 
+ * ou nao
+ * 
+ * Nao e recursiva: os vertices em visita ficam na pilha recebida (vazia),
+ * junto da proxima aresta de cada um. Assim grafos com caminhos muito
+ * longos nao estouram a pilha de chamadas. Os tempos e a arvore de busca
+ * sao os mesmos da versao recursiva
+*/
+void buscaProfundidaVisita(Vertice G[], int ordem, int verticeAtual, int *tempo, int componente, Pilha *pilha,
+                           ResultadoBuscaProfundidade *resultado)
+{
+    ItemPilha *item;
+    Aresta *aux;
+
+    if (verticeAtual < 0 || verticeAtual >= ordem) /* Testo se vertice e valido */
+        return;
+
+    descobreVertice(resultado, verticeAtual, tempo, componente);
+    empilha(pilha, verticeAtual)->proximo.aresta = G[verticeAtual].prim;
+
+    while (!pilhaEstaVazia(pilha))
+    {
+        item = topoPilha(pilha);
+
+        /*Avancando ate o proximo vizinho ainda nao visitado, evitando repeticoes*/
+        aux = item->proximo.aresta;
+        while (aux != NULL && TESTA_BIT(resultado->visitados, aux->nome))
+        {
+            CONTA_ARESTAS(1);
+            aux = aux->prox;
+        }
+
+        if (aux == NULL)
+        {
+            /*Todos os vizinhos visitados: vertice finalizado*/
+            finalizaVertice(resultado, item->vertice, tempo);
+            desempilha(pilha);
+            continue;
+        }
+
+        /*Na volta para este vertice, a busca continua depois de aux*/
+        item->proximo.aresta = aux->prox;
+        CONTA_ARESTAS(1);
+
+        resultado->pai[aux->nome] = item->vertice; /*Criacao de arvore de busca*/
+        descobreVertice(resultado, aux->nome, tempo, componente);
+        empilha(pilha, aux->nome)->proximo.aresta = G[aux->nome].prim;
+    }
+}
+
+/**
+ * Funcao de utilidade usada para definir se um grafo e conexo
+ * ou nao a partir da buscaProfundida
+ * 
+ * A presente funcao conta quantos componentes estao definidos no 
+ * vetor componente, com a componente de cada vertice.
+ * Como as componentes sao nomeadas por um de seus vertices, basta
+ * marcar cada nome ja encontrado em um vetor: uma unica passada
+*/
+int numComponentes(int componente[], int ordem)
+{
+    bool *componentesDefinidos;
+    int encontrados;
+    int i;
+
+    componentesDefinidos = (bool *)calloc(ordem > 0 ? ordem : 1, sizeof(bool));
+    encontrados = 0;
+
+    for (i = 0; i < ordem; i++)
+    {
+        int componenteAtual = componente[i];
+        if (componenteAtual < 0 || componenteAtual >= ordem)
+        {
+            /*Componente não definido encontrado, nao incluso na contagem*/
+            continue;
+        }
+
+        if (!componentesDefinidos[componenteAtual])
+        {
+            componentesDefinidos[componenteAtual] = true;
+            encontrados++;
+        }
+    }
+
+    free(componentesDefinidos);
+    return encontrados;
+}
+
+bool eConexoBProf(ResultadoBuscaProfundidade *resultado)
+{
+    /*
+    Definição de grafo conexo: se para todo o par de 
+    vertices, existe um caminho entre eles, e temos 
+    pelo menos um vértice. Ou seja, se temos uma, e somente,
+    uma componente definida nele. 
+
+    Importante: grafos vazios não são conexos.
+    */
+
+    return numComponentes(resultado->componente, resultado->ordem) == 1;
+}
+
+/*
+ * Implementacao das operacoes de conjuntos disjuntos
+ */
+
+/**
+ * Devolve a raiz do conjunto do vertice v: um no entre 0 e 2 * ordem - 1,
+ * igual para todos os vertices da mesma componente. No caminho ate a raiz,
+ * cada no passa a apontar para o seu avo (divisao de caminho),
+ * o que mantem as arvores rasas sem precisar de recursao
+*/
+int encontraConjunto(Vertice G[], int v)
+{
+    DadosGrafo *dados = dadosGrafo(G);
+
+    return raizConjunto(dados, dados->noVertice[v]);
+}
+
+bool mesmaComponente(Vertice G[], int ordem, int v1, int v2)
+{
+    if (v1 < 0 || v1 >= ordem || v2 < 0 || v2 >= ordem) /* Testo se vertices sao validos */
+        return false;
+
+    return encontraConjunto(G, v1) == encontraConjunto(G, v2);
+}
+
+/*  Numero de componentes, mantido a cada aresta: nenhuma busca e necessaria */
+int numComponentesConjuntos(Vertice G[])
+{
+    return dadosGrafo(G)->numConjuntos;
+}
+
+/* Mesma definicao de eConexoBProf: grafos vazios nao sao conexos */
+bool eConexoConjuntos(Vertice G[])
+{
+    return numComponentesConjuntos(G) == 1;
+}
+
+/**
+ * Marca a componente de todos os vertices a partir dos conjuntos,
+ * sem percorrer as arestas. Cada componente recebe o nome do seu menor
+ * vertice, o mesmo nome dado por buscaProfundida
+*/
+void definirComponentesConjuntos(Vertice G[], int ordem)
+{
+    int *nomeConjunto;
+    int i, raiz;
+
+    nomeConjunto = (int *)malloc(sizeof(int) * (ordem > 0 ? 2 * ordem : 1));
+    for (i = 0; i < 2 * ordem; i++)
+        nomeConjunto[i] = ELEMENTO_NAO_DEFINIDO;
+
+    /*Vertices em ordem crescente: o primeiro de cada conjunto e o menor*/
+    for (i = 0; i < ordem; i++)
+    {
+        raiz = encontraConjunto(G, i);
+        if (nomeConjunto[raiz] == ELEMENTO_NAO_DEFINIDO)
+            nomeConjunto[raiz] = i;
+        G[i].componente = nomeConjunto[raiz];
+    }
+
+    free(nomeConjunto);
+}
+
+/*
+ * Implementacao das funcoes da representacao compacta (CSR)
+ */
+
+/**
+ * Reserva a estrutura CSR para um grafo de ordem e numero de
+ * semi-arestas conhecidos. O vetor inicio e zerado, para ser
+ * usado na contagem dos graus
+*/
+static GrafoCSR *alocaGrafoCSR(int ordem, int numSemiArestas)
+{
+    GrafoCSR *csr = (GrafoCSR *)malloc(sizeof(GrafoCSR));
+
+    csr->ordem = ordem;
+    csr->numSemiArestas = numSemiArestas;
+    csr->mapeamento = NULL;
+    csr->tamanhoMapeamento = 0;
+    csr->inicio = (int *)calloc(ordem + 1, sizeof(int));
+    csr->vizinhos = (int *)malloc(sizeof(int) * (numSemiArestas > 0 ? numSemiArestas : 1));
+
+    return csr;
+}
+
+/**
+ * Congela um grafo representado por listas de adjacencia na forma CSR.
+ * A ordem dos vizinhos de cada vertice e a mesma das listas, de forma que
+ * as buscas sobre as duas representacoes produzem os mesmos resultados
+*/
+GrafoCSR *criaGrafoCSR(Vertice G[], int ordem)
+{
+    GrafoCSR *csr;
+    Aresta *aux;
+    int i, total;
+
+    /*O numero de semi-arestas e mantido pelo grafo: uma unica passada pelas listas*/
+    csr = alocaGrafoCSR(ordem, 2 * dadosGrafo(G)->numArestas);
+
+    /*Copia dos vizinhos para o vetor contiguo*/
+    total = 0;
+    for (i = 0; i < ordem; i++)
+    {
+        csr->inicio[i] = total;
+        for (aux = G[i].prim; aux != NULL; aux = aux->prox)
+            csr->vizinhos[total++] = aux->nome;
+    }
+    csr->inicio[ordem] = total;
+
+    return csr;
+}
+
+/**
+ * Cria um grafo CSR diretamente de uma lista de arestas, sem passar pelas
+ * listas encadeadas. O vetor arestas guarda os pares de extremos em sequencia:
+ * (arestas[0], arestas[1]) e a primeira aresta, (arestas[2], arestas[3]) a segunda...
+ *
+ * Arestas com extremos invalidos sao ignoradas, como em acrescentaAresta.
+ * Os vizinhos ficam na mesma ordem que teriam se as arestas fossem
+ * acrescentadas uma a uma (a mais recente primeiro)
+*/
+GrafoCSR *criaGrafoCSRArestas(int ordem, int arestas[], int numArestas)
+{
+    GrafoCSR *csr;
+    int *posicao;
+    int i, v1, v2, total;
+
+    /*Contagem dos graus, deslocada de uma posicao em inicio*/
+    csr = alocaGrafoCSR(ordem, 0);
+    total = 0;
+    for (i = 0; i < numArestas; i++)
+    {
+        v1 = arestas[2 * i];
+        v2 = arestas[2 * i + 1];
+        if (v1 < 0 || v1 >= ordem || v2 < 0 || v2 >= ordem) /* Testo se vertices sao validos */
+            continue;
+        csr->inicio[v1 + 1]++;
+        csr->inicio[v2 + 1]++;
+        total += 2;
+    }
+
+    /*Soma de prefixos: inicio[i] passa a ser a posicao do primeiro vizinho de i*/
+    for (i = 0; i < ordem; i++)
+        csr->inicio[i + 1] += csr->inicio[i];
+
+    free(csr->vizinhos);
+    csr->numSemiArestas = total;
+    csr->vizinhos = (int *)malloc(sizeof(int) * (total > 0 ? total : 1));
+
+    /*Preenchimento de tras para frente: a ultima aresta fica no inicio da lista*/
+    posicao = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    for (i = 0; i < ordem; i++)
+        posicao[i] = csr->inicio[i + 1];
+
+    for (i = 0; i < numArestas; i++)
+    {
+        v1 = arestas[2 * i];
+        v2 = arestas[2 * i + 1];
+        if (v1 < 0 || v1 >= ordem || v2 < 0 || v2 >= ordem)
+            continue;
+        csr->vizinhos[--posicao[v1]] = v2;
+        csr->vizinhos[--posicao[v2]] = v1;
+    }
+
+    free(posicao);
+    return csr;
+}
+
+void liberaGrafoCSR(GrafoCSR *csr)
+{
+    if (csr->mapeamento != NULL)
+        munmap(csr->mapeamento, csr->tamanhoMapeamento);
+    else
+    {
+        free(csr->inicio);
+        free(csr->vizinhos);
+    }
+    free(csr);
+}
+
+/**
+ * Grava o grafo CSR no formato binario descrito em CabecalhoArquivoGrafo.
+ * Retorna 1 em caso de sucesso e 0 se o arquivo nao puder ser escrito
+*/
+int gravaGrafoCSR(GrafoCSR *csr, const char *nomeArquivo)
+{
+    CabecalhoArquivoGrafo cabecalho;
+    FILE *arquivo;
+    int ok;
+
+    arquivo = fopen(nomeArquivo, "wb");
+    if (arquivo == NULL)
+        return 0;
+
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.assinatura, ASSINATURA_ARQUIVO_GRAFO, sizeof(cabecalho.assinatura));
+    cabecalho.versao = VERSAO_ARQUIVO_GRAFO;
+    cabecalho.ordem = csr->ordem;
+    cabecalho.numSemiArestas = csr->numSemiArestas;
+
+    ok = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1;
+    ok = ok && fwrite(csr->inicio, sizeof(int), csr->ordem + 1, arquivo) == (size_t)(csr->ordem + 1);
+    ok = ok && fwrite(csr->vizinhos, sizeof(int), csr->numSemiArestas, arquivo) == (size_t)csr->numSemiArestas;
+
+    if (fclose(arquivo) != 0)
+        ok = 0;
+    return ok;
+}
+
+/**
+ * Confere a estrutura de um grafo CSR lido de fora: inicio comeca em zero,
+ * nunca diminui e termina em numSemiArestas, e todo vizinho e um vertice
+ * valido. Sem isso, as buscas leriam fora dos vetores
+*/
+static bool validaEstruturaCSR(int ordem, int numSemiArestas, const int inicio[], const int vizinhos[])
+{
+    int i;
+
+    if (inicio[0] != 0 || inicio[ordem] != numSemiArestas)
+        return false;
+    for (i = 0; i < ordem; i++)
+        if (inicio[i] > inicio[i + 1])
+            return false;
+    for (i = 0; i < numSemiArestas; i++)
+        if (vizinhos[i] < 0 || vizinhos[i] >= ordem)
+            return false;
+
+    return true;
+}
+
+/**
+ * Carrega um grafo gravado por gravaGrafoCSR, mapeando o arquivo na memoria:
+ * nada e copiado, e os vetores sao lidos uma unica vez para conferir a sua
+ * estrutura (validaEstruturaCSR). O grafo e apenas de leitura e o mapeamento
+ * e desfeito por liberaGrafoCSR.
+ * 
+ * Retorna NULL se o arquivo nao existir ou nao estiver no formato esperado
+*/
+GrafoCSR *carregaGrafoCSR(const char *nomeArquivo)
+{
+    CabecalhoArquivoGrafo *cabecalho;
+    GrafoCSR *csr;
+    struct stat dadosArquivo;
+    void *mapeamento;
+    size_t tamanhoEsperado;
+    int descritor;
+
+    descritor = open(nomeArquivo, O_RDONLY);
+    if (descritor < 0)
+        return NULL;
+
+    if (fstat(descritor, &dadosArquivo) != 0 || (size_t)dadosArquivo.st_size < sizeof(CabecalhoArquivoGrafo))
+    {
+        close(descritor);
+        return NULL;
+    }
+
+    mapeamento = mmap(NULL, dadosArquivo.st_size, PROT_READ, MAP_PRIVATE, descritor, 0);
+    close(descritor); /* o mapeamento continua valido sem o descritor */
+    if (mapeamento == MAP_FAILED)
+        return NULL;
+
+    /*Validacao do cabecalho e do tamanho do arquivo*/
+    cabecalho = (CabecalhoArquivoGrafo *)mapeamento;
+    tamanhoEsperado = sizeof(CabecalhoArquivoGrafo) +
+                      sizeof(int) * ((size_t)cabecalho->ordem + 1 + (size_t)cabecalho->numSemiArestas);
+    if (memcmp(cabecalho->assinatura, ASSINATURA_ARQUIVO_GRAFO, sizeof(cabecalho->assinatura)) != 0 ||
+        cabecalho->versao != VERSAO_ARQUIVO_GRAFO || cabecalho->ordem < 0 || cabecalho->numSemiArestas < 0 ||
+        (size_t)dadosArquivo.st_size != tamanhoEsperado)
+    {
+        munmap(mapeamento, dadosArquivo.st_size);
+        return NULL;
+    }
+
+    /*Validacao dos vetores: uma passada por inicio e outra por vizinhos*/
+    csr = (GrafoCSR *)malloc(sizeof(GrafoCSR));
+    if (csr == NULL || !validaEstruturaCSR(cabecalho->ordem, cabecalho->numSemiArestas, (int *)(cabecalho + 1),
+                                           (int *)(cabecalho + 1) + cabecalho->ordem + 1))
+    {
+        free(csr);
+        munmap(mapeamento, dadosArquivo.st_size);
+        return NULL;
+    }
+
+    csr->ordem = cabecalho->ordem;
+    csr->numSemiArestas = cabecalho->numSemiArestas;
+    csr->inicio = (int *)(cabecalho + 1);
+    csr->vizinhos = csr->inicio + csr->ordem + 1;
+    csr->mapeamento = mapeamento;
+    csr->tamanhoMapeamento = dadosArquivo.st_size;
+
+    return csr;
+}
+
+/*  Funcao que retorna o tamanho de um grafo CSR, sem percorrer os vizinhos */
+int calculaTamanhoCSR(GrafoCSR *csr)
+{
+    return csr->numSemiArestas / 2 + csr->ordem;
+}
+
+/**
+ * Imprime o grafo CSR. O vetor componente, com a componente de
+ * cada vertice, pode ser NULL se elas nao tiverem sido definidas
+*/
+void imprimeGrafoCSR(GrafoCSR *csr, int componente[])
+{
+    int i, j;
+
+    printf("Ordem:       %d\n", csr->ordem);
+    printf("Tamanho:     %d\n", calculaTamanhoCSR(csr));
+    printf("===Lista de Adjacencia===:\n");
+
+    for (i = 0; i < csr->ordem; i++)
+    {
+        printf("V%d (Comp:%2d): ", i, componente != NULL ? componente[i] : ELEMENTO_NAO_DEFINIDO);
+        for (j = csr->inicio[i]; j < csr->inicio[i + 1]; j++)
+            printf("%3d", csr->vizinhos[j]);
+
+        printf("\n");
+    }
+    printf("=========================:\n\n");
+}
+
+/**
+ * Mesma busca em largura de buscaLargura, percorrendo os
+ * vizinhos no vetor contiguo em vez das listas encadeadas
+*/
+void buscaLarguraCSR(GrafoCSR *csr, int verticeInicial, ResultadoBuscaLargura *resultado)
+{
+    Fila *Q;
+    int *distancia = resultado->distancia;
+    int *pai = resultado->pai;
+    PalavraBits *visitados = resultado->visitados;
+    int j;
+
+    iniciaResultadoBuscaLargura(resultado);
+
+    if (verticeInicial < 0 || verticeInicial >= csr->ordem) /* Testo se vertice e valido */
+        return;
+
+    MARCA_BIT(visitados, verticeInicial);
+    distancia[verticeInicial] = 0;
+    REGISTRA_FRONTEIRA(0, 1);
+
+    Q = inicializaFila(csr->ordem);
+    enfileira(Q, verticeInicial);
+
+    while (!filaEstaVazia(Q))
+    {
+        int u = desinfileira(Q);
+
+        CONTA_ARESTAS(csr->inicio[u + 1] - csr->inicio[u]);
+        for (j = csr->inicio[u]; j < csr->inicio[u + 1]; j++)
+        {
+            int w = csr->vizinhos[j];
+            if (!TESTA_BIT(visitados, w))
+            {
+                MARCA_BIT(visitados, w);
+                distancia[w] = distancia[u] + 1;
+                pai[w] = u;
+                REGISTRA_FRONTEIRA(distancia[w], 1);
+
+                enfileira(Q, w);
+            }
+        }
+    }
+
+    liberaFila(Q);
+}
+
+/**
+ * Busca em largura que alterna entre dois modos a cada nivel:
+ * 
+ * - de cima para baixo: cada vertice da fronteira examina seus vizinhos
+ *   e descobre os que ainda nao foram visitados, como em buscaLargura;
+ * - de baixo para cima: cada vertice nao visitado procura, entre seus
+ *   vizinhos, um que esteja na fronteira, parando no primeiro encontrado.
+ * 
+ * Quando a fronteira e grande, quase todos os vizinhos examinados de cima
+ * para baixo ja foram visitados, e o segundo modo examina bem menos arestas.
+ * As distancias sao as mesmas de buscaLarguraCSR; os pais formam uma arvore
+ * de busca em largura valida, mas podem ser outros
+*/
+void buscaLarguraHibridaCSR(GrafoCSR *csr, int verticeInicial, ResultadoBuscaLargura *resultado)
+{
+    int *fronteira, *proxima, *troca;
+    int *distancia = resultado->distancia;
+    int *pai = resultado->pai;
+    PalavraBits *visitados = resultado->visitados;
+    int tamanhoFronteira, tamanhoProxima;
+    int arestasFronteira, arestasNaoExploradas;
+    int nivel, i, j, u, w;
+    bool deBaixoParaCima;
+
+    iniciaResultadoBuscaLargura(resultado);
+
+    if (verticeInicial < 0 || verticeInicial >= csr->ordem) /* Testo se vertice e valido */
+        return;
+
+    fronteira = (int *)malloc(sizeof(int) * csr->ordem);
+    proxima = (int *)malloc(sizeof(int) * csr->ordem);
+
+    MARCA_BIT(visitados, verticeInicial);
+    distancia[verticeInicial] = 0;
+    fronteira[0] = verticeInicial;
+    tamanhoFronteira = 1;
+    REGISTRA_FRONTEIRA(0, 1);
+
+    arestasNaoExploradas = csr->numSemiArestas;
+    arestasNaoExploradas -= csr->inicio[verticeInicial + 1] - csr->inicio[verticeInicial];
+
+    deBaixoParaCima = false;
+    for (nivel = 0; tamanhoFronteira > 0; nivel++)
+    {
+        arestasFronteira = 0;
+        for (i = 0; i < tamanhoFronteira; i++)
+            arestasFronteira += csr->inicio[fronteira[i] + 1] - csr->inicio[fronteira[i]];
+
+        /*Escolha do modo do nivel atual*/
+        if (!deBaixoParaCima && arestasFronteira > arestasNaoExploradas / ALFA_BUSCA_HIBRIDA)
+            deBaixoParaCima = true;
+        else if (deBaixoParaCima && tamanhoFronteira < csr->ordem / BETA_BUSCA_HIBRIDA)
+            deBaixoParaCima = false;
+
+        tamanhoProxima = 0;
+        if (deBaixoParaCima)
+        {
+            /*Um vertice esta na fronteira se foi descoberto exatamente no nivel atual*/
+            for (u = 0; u < csr->ordem; u++)
+            {
+                if (TESTA_BIT(visitados, u))
+                    continue;
+
+                for (j = csr->inicio[u]; j < csr->inicio[u + 1]; j++)
+                {
+                    w = csr->vizinhos[j];
+                    CONTA_ARESTAS(1);
+                    if (distancia[w] == nivel)
+                    {
+                        MARCA_BIT(visitados, u);
+                        distancia[u] = nivel + 1;
+                        pai[u] = w;
+                        proxima[tamanhoProxima++] = u;
+                        break;
+                    }
+                }
+            }
+        }
+        else
+        {
+            for (i = 0; i < tamanhoFronteira; i++)
+            {
+                u = fronteira[i];
+                CONTA_ARESTAS(csr->inicio[u + 1] - csr->inicio[u]);
+                for (j = csr->inicio[u]; j < csr->inicio[u + 1]; j++)
+                {
+                    w = csr->vizinhos[j];
+                    if (!TESTA_BIT(visitados, w))
+                    {
+                        MARCA_BIT(visitados, w);
+                        distancia[w] = nivel + 1;
+                        pai[w] = u;
+                        proxima[tamanhoProxima++] = w;
+                    }
+                }
+            }
+        }
+
+        for (i = 0; i < tamanhoProxima; i++)
+            arestasNaoExploradas -= csr->inicio[proxima[i] + 1] - csr->inicio[proxima[i]];
+        CONTA_ENFILEIRAMENTOS(tamanhoProxima);
+        if (tamanhoProxima > 0)
+            REGISTRA_FRONTEIRA(nivel + 1, tamanhoProxima);
+
+        troca = fronteira;
+        fronteira = proxima;
+        proxima = troca;
+        tamanhoFronteira = tamanhoProxima;
+    }
+
+    free(fronteira);
+    free(proxima);
+}
+
+/**
+ * Marca o bit de v de forma atomica. Retorna true apenas para a
+ * thread que mudou o bit, quando varias tentam marcar o mesmo vertice
+*/
+static bool marcaBitAtomico(PalavraBits mapa[], int v)
+{
+    PalavraBits bit = 1u << (v % BITS_POR_PALAVRA);
+
+    if (mapa[v / BITS_POR_PALAVRA] & bit)
+        return false;
+    return (__sync_fetch_and_or(&mapa[v / BITS_POR_PALAVRA], bit) & bit) == 0;
+}
+
+/* Espera todas as threads da busca chegarem ao mesmo ponto */
+static void sincronizaThreads(BuscaParalela *busca)
+{
+#ifdef BUSCA_PARALELA
+    if (busca->numThreads > 1)
+        pthread_barrier_wait(&busca->barreira);
+#else
+    (void)busca;
+#endif
+}
+
+/* Copia os vertices descobertos por uma thread para a proxima fronteira */
+static void descarregaBuffer(BuscaParalela *busca, int buffer[], int *tamanhoBuffer)
+{
+    int posicao;
+
+    if (*tamanhoBuffer == 0)
+        return;
+
+    posicao = __sync_fetch_and_add(&busca->tamanhoProxima, *tamanhoBuffer);
+    memcpy(&busca->proxima[posicao], buffer, sizeof(int) * *tamanhoBuffer);
+    *tamanhoBuffer = 0;
+}
+
+/**
+ * Trabalho de cada thread da busca em largura paralela, nivel a nivel.
+ * Um vertice so e descoberto pela thread que conseguir marcar seu bit de
+ * visitado de forma atomica; apenas ela escreve seu pai e distancia
+*/
+static void *trabalhoBuscaParalela(void *argumento)
+{
+    ThreadBusca *thread = (ThreadBusca *)argumento;
+    BuscaParalela *busca = thread->busca;
+    GrafoCSR *csr = busca->csr;
+    ResultadoBuscaLargura *resultado = busca->resultado;
+    int buffer[TAMANHO_BUFFER_THREAD];
+    int tamanhoBuffer, inicioBloco, fimBloco;
+    int *troca;
+    int i, j, u, w;
+#ifdef INSTRUMENTACAO
+    unsigned long arestasThread, descobertosThread;
+#endif
+
+    while (busca->tamanhoFronteira > 0)
+    {
+        tamanhoBuffer = 0;
+#ifdef INSTRUMENTACAO
+        arestasThread = 0;
+        descobertosThread = 0;
+#endif
+
+        while ((inicioBloco = __sync_fetch_and_add(&busca->proximoBloco, BLOCO_FRONTEIRA)) < busca->tamanhoFronteira)
+        {
+            fimBloco = inicioBloco + BLOCO_FRONTEIRA;
+            if (fimBloco > busca->tamanhoFronteira)
+                fimBloco = busca->tamanhoFronteira;
+
+            for (i = inicioBloco; i < fimBloco; i++)
+            {
+                u = busca->fronteira[i];
+#ifdef INSTRUMENTACAO
+                arestasThread += csr->inicio[u + 1] - csr->inicio[u];
+#endif
+                for (j = csr->inicio[u]; j < csr->inicio[u + 1]; j++)
+                {
+                    w = csr->vizinhos[j];
+                    if (marcaBitAtomico(resultado->visitados, w))
+                    {
+#ifdef INSTRUMENTACAO
+                        descobertosThread++;
+#endif
+                        resultado->distancia[w] = busca->nivel + 1;
+                        resultado->pai[w] = u;
+
+                        if (tamanhoBuffer == TAMANHO_BUFFER_THREAD)
+                            descarregaBuffer(busca, buffer, &tamanhoBuffer);
+                        buffer[tamanhoBuffer++] = w;
+                    }
+                }
+            }
+        }
+
+        descarregaBuffer(busca, buffer, &tamanhoBuffer);
+        CONTA_ARESTAS_ATOMICO(arestasThread);
+        CONTA_ENFILEIRAMENTOS_ATOMICO(descobertosThread);
+        sincronizaThreads(busca);
+
+        /*Nivel terminado: a thread 0 prepara o proximo*/
+        if (thread->indice == 0)
+        {
+            if (busca->tamanhoProxima > 0)
+                REGISTRA_FRONTEIRA(busca->nivel + 1, busca->tamanhoProxima);
+            troca = busca->fronteira;
+            busca->fronteira = busca->proxima;
+            busca->proxima = troca;
+            busca->tamanhoFronteira = busca->tamanhoProxima;
+            busca->tamanhoProxima = 0;
+            busca->proximoBloco = 0;
+            busca->nivel++;
+        }
+        sincronizaThreads(busca);
+    }
+
+    return NULL;
+}
+
+/**
+ * Busca em largura sincronizada por niveis, com a expansao de cada
+ * nivel dividida entre numThreads threads. Produz as mesmas distancias
+ * de buscaLarguraCSR; os pais formam uma arvore de busca valida.
+ * 
+ * As threads so sao criadas quando o programa e compilado com
+ * BUSCA_PARALELA (make PARALELO=1); caso contrario a busca e feita
+ * pela thread atual, com o mesmo algoritmo
+*/
+void buscaLarguraParalelaCSR(GrafoCSR *csr, int verticeInicial, int numThreads, ResultadoBuscaLargura *resultado)
+{
+    BuscaParalela busca;
+    ThreadBusca *threads;
+    int i;
+#ifdef BUSCA_PARALELA
+    pthread_t *identificadores;
+#endif
+
+    iniciaResultadoBuscaLargura(resultado);
+
+    if (verticeInicial < 0 || verticeInicial >= csr->ordem) /* Testo se vertice e valido */
+        return;
+
+#ifndef BUSCA_PARALELA
+    numThreads = 1;
+#endif
+    if (numThreads < 1)
+        numThreads = 1;
+
+    busca.csr = csr;
+    busca.resultado = resultado;
+    busca.fronteira = (int *)malloc(sizeof(int) * csr->ordem);
+    busca.proxima = (int *)malloc(sizeof(int) * csr->ordem);
+    busca.tamanhoProxima = 0;
+    busca.proximoBloco = 0;
+    busca.nivel = 0;
+    busca.numThreads = numThreads;
+
+    MARCA_BIT(resultado->visitados, verticeInicial);
+    resultado->distancia[verticeInicial] = 0;
+    busca.fronteira[0] = verticeInicial;
+    busca.tamanhoFronteira = 1;
+    REGISTRA_FRONTEIRA(0, 1);
+
+    threads = (ThreadBusca *)malloc(sizeof(ThreadBusca) * numThreads);
+    for (i = 0; i < numThreads; i++)
+    {
+        threads[i].busca = &busca;
+        threads[i].indice = i;
+    }
+
+#ifdef BUSCA_PARALELA
+    pthread_barrier_init(&busca.barreira, NULL, numThreads);
+    identificadores = (pthread_t *)malloc(sizeof(pthread_t) * numThreads);
+    for (i = 1; i < numThreads; i++)
+        pthread_create(&identificadores[i], NULL, trabalhoBuscaParalela, &threads[i]);
+#endif
+
+    trabalhoBuscaParalela(&threads[0]);
+
+#ifdef BUSCA_PARALELA
+    for (i = 1; i < numThreads; i++)
+        pthread_join(identificadores[i], NULL);
+    pthread_barrier_destroy(&busca.barreira);
+    free(identificadores);
+#endif
+
+    free(threads);
+    free(busca.fronteira);
+    free(busca.proxima);
+}
+
+/**
+ * Tarefa executada por uma thread sobre os vertices de inicio ate fim - 1
+*/
+typedef void (*TarefaIntervalo)(void *dados, int inicio, int fim);
+
+typedef struct threadIntervalo
+{
+    TarefaIntervalo tarefa;
+    void *dados;
+    int inicio;
+    int fim;
+} ThreadIntervalo;
+
+#ifdef BUSCA_PARALELA
+static void *trabalhoIntervalo(void *argumento)
+{
+    ThreadIntervalo *thread = (ThreadIntervalo *)argumento;
+    thread->tarefa(thread->dados, thread->inicio, thread->fim);
+    return NULL;
+}
+#endif
+
+/**
+ * Divide os vertices 0 ate n - 1 em numThreads intervalos do mesmo tamanho
+ * e executa a tarefa em cada um, em paralelo, retornando quando todas
+ * terminarem. Sem BUSCA_PARALELA, executa a tarefa de uma vez, nesta thread
+*/
+static void executaEmParalelo(TarefaIntervalo tarefa, void *dados, int n, int numThreads)
+{
+#ifdef BUSCA_PARALELA
+    ThreadIntervalo *threads;
+    pthread_t *identificadores;
+    int i;
+
+    if (numThreads > 1 && n >= numThreads)
+    {
+        threads = (ThreadIntervalo *)malloc(sizeof(ThreadIntervalo) * numThreads);
+        identificadores = (pthread_t *)malloc(sizeof(pthread_t) * numThreads);
+
+        for (i = 0; i < numThreads; i++)
+        {
+            threads[i].tarefa = tarefa;
+            threads[i].dados = dados;
+            threads[i].inicio = (int)((long)n * i / numThreads);
+            threads[i].fim = (int)((long)n * (i + 1) / numThreads);
+            pthread_create(&identificadores[i], NULL, trabalhoIntervalo, &threads[i]);
+        }
+        for (i = 0; i < numThreads; i++)
+            pthread_join(identificadores[i], NULL);
+
+        free(threads);
+        free(identificadores);
+        return;
+    }
+#else
+    (void)numThreads;
+#endif
+    tarefa(dados, 0, n);
+}
+
+/**
+ * Estado das componentes conexas paralelas: cada vertice aponta para
+ * um vertice de menor nome na mesma componente, ate chegar ao menor
+ * de todos, que aponta para si mesmo
+*/
+typedef struct componentesParalelo
+{
+    GrafoCSR *csr;
+    GrafoComprimido *comprimido; /* usado apenas por definirComponentesComprimido */
+    int *comp;
+    int rodada;          /* vizinho ligado na fase de rodadas */
+    int componenteMaior; /* componente a ser ignorada na fase final */
+} ComponentesParalelo;
+
+/**
+ * Liga as arvores de u e v sem travas: a raiz de maior nome passa a apontar
+ * para o menor, com troca atomica. Se outra thread mudar a raiz antes, a
+ * tentativa e refeita a partir dos novos valores
+*/
+static void ligaComponentes(int comp[], int u, int v)
+{
+    int p1 = comp[u];
+    int p2 = comp[v];
+    int maior, menor, paiMaior;
+
+    while (p1 != p2)
+    {
+        maior = p1 > p2 ? p1 : p2;
+        menor = p1 + p2 - maior;
+        paiMaior = comp[maior];
+
+        if (paiMaior == menor)
+            break;
+        if (paiMaior == maior && __sync_bool_compare_and_swap(&comp[maior], maior, menor))
+            break;
+
+        p1 = comp[comp[maior]];
+        p2 = comp[menor];
+    }
+}
+
+static void tarefaIniciaComponentes(void *dados, int inicio, int fim)
+{
+    ComponentesParalelo *cp = (ComponentesParalelo *)dados;
+    int v;
+
+    for (v = inicio; v < fim; v++)
+        cp->comp[v] = v;
+}
+
+/* Faz cada vertice apontar direto para a raiz de sua arvore */
+static void tarefaCompactaComponentes(void *dados, int inicio, int fim)
+{
+    ComponentesParalelo *cp = (ComponentesParalelo *)dados;
+    int *comp = cp->comp;
+    int v;
+
+    for (v = inicio; v < fim; v++)
+        while (comp[v] != comp[comp[v]])
+            comp[v] = comp[comp[v]];
+}
+
+/* Liga cada vertice apenas ao seu vizinho de numero cp->rodada */
+static void tarefaRodadaVizinhos(void *dados, int inicio, int fim)
+{
+    ComponentesParalelo *cp = (ComponentesParalelo *)dados;
+    GrafoCSR *csr = cp->csr;
+    int u;
+
+    for (u = inicio; u < fim; u++)
+        if (csr->inicio[u] + cp->rodada < csr->inicio[u + 1])
+            ligaComponentes(cp->comp, u, csr->vizinhos[csr->inicio[u] + cp->rodada]);
+}
+
+/**
+ * Liga os vizinhos restantes dos vertices fora da maior componente.
+ * Como cada aresta aparece nos dois extremos, as arestas entre a maior
+ * componente e o resto sao vistas pelo extremo de fora dela
+*/
+static void tarefaVizinhosRestantes(void *dados, int inicio, int fim)
+{
+    ComponentesParalelo *cp = (ComponentesParalelo *)dados;
+    GrafoCSR *csr = cp->csr;
+    int u, j;
+
+    for (u = inicio; u < fim; u++)
+    {
+        if (cp->comp[u] == cp->componenteMaior)
+            continue;
+        for (j = csr->inicio[u] + RODADAS_VIZINHOS_COMPONENTES; j < csr->inicio[u + 1]; j++)
+            ligaComponentes(cp->comp, u, csr->vizinhos[j]);
+    }
+}
+
+static int comparaInteiros(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Componente mais frequente entre AMOSTRAS_COMPONENTES vertices sorteados.
+ * Usa um gerador proprio, para nao alterar a sequencia de rand()
+*/
+static int amostraComponenteMaior(int comp[], int ordem)
+{
+    int amostras[AMOSTRAS_COMPONENTES];
+    unsigned long semente = 12345;
+    int i, maior, repeticoes, maisRepeticoes;
+
+    for (i = 0; i < AMOSTRAS_COMPONENTES; i++)
+    {
+        semente = (semente * 1103515245UL + 12345UL) & 0x7fffffffUL;
+        amostras[i] = comp[semente % ordem];
+    }
+    qsort(amostras, AMOSTRAS_COMPONENTES, sizeof(int), comparaInteiros);
+
+    maior = amostras[0];
+    maisRepeticoes = 0;
+    repeticoes = 0;
+    for (i = 0; i < AMOSTRAS_COMPONENTES; i++)
+    {
+        repeticoes = (i > 0 && amostras[i] == amostras[i - 1]) ? repeticoes + 1 : 1;
+        if (repeticoes > maisRepeticoes)
+        {
+            maisRepeticoes = repeticoes;
+            maior = amostras[i];
+        }
+    }
+
+    return maior;
+}
+
+/**
+ * Componentes conexas em paralelo (algoritmo Afforest), sem busca.
+ * 
+ * Primeiro cada vertice e ligado apenas aos seus primeiros vizinhos, o que
+ * ja forma quase toda a maior componente. Por amostragem essa componente e
+ * identificada, e apenas os vertices fora dela examinam o resto das arestas.
+ * 
+ * A componente de cada vertice e escrita no vetor componente, com o nome do
+ * menor vertice da componente, o mesmo usado por buscaProfundida
+*/
+void definirComponentesParaleloCSR(GrafoCSR *csr, int componente[], int numThreads)
+{
+    ComponentesParalelo cp;
+
+    if (csr->ordem == 0)
+        return;
+
+    cp.csr = csr;
+    cp.comp = componente;
+    cp.componenteMaior = ELEMENTO_NAO_DEFINIDO;
+
+    executaEmParalelo(tarefaIniciaComponentes, &cp, csr->ordem, numThreads);
+
+    for (cp.rodada = 0; cp.rodada < RODADAS_VIZINHOS_COMPONENTES; cp.rodada++)
+    {
+        executaEmParalelo(tarefaRodadaVizinhos, &cp, csr->ordem, numThreads);
+        executaEmParalelo(tarefaCompactaComponentes, &cp, csr->ordem, numThreads);
+    }
+
+    cp.componenteMaior = amostraComponenteMaior(cp.comp, csr->ordem);
+    executaEmParalelo(tarefaVizinhosRestantes, &cp, csr->ordem, numThreads);
+    executaEmParalelo(tarefaCompactaComponentes, &cp, csr->ordem, numThreads);
+}
+
+/**
+ * Estado da construcao paralela do grafo CSR. A soma de prefixos e feita
+ * em numBlocos blocos de vertices: cada bloco soma seus graus, os totais
+ * dos blocos sao acumulados, e cada bloco entao acumula os seus a partir dali
+*/
+typedef struct construcaoCSR
+{
+    GrafoCSR *csr;
+    int *arestas;
+    int numArestas;
+    int opcoes;
+    bool atomico; /* mais de uma thread escrevendo em graus e posicoes */
+
+    int *valores; /* vetor da soma de prefixos em andamento */
+    int numValores;
+    int numBlocos;
+    int *somaBloco; /* soma dos valores anteriores a cada bloco */
+
+    int *posicao; /* proxima posicao livre na lista de cada vertice */
+    int *grau;    /* graus depois da remocao de repetidas, depois inicio das novas listas */
+    int *vizinhosNovo;
+} ConstrucaoCSR;
+
+/* Se a aresta i deve entrar no grafo, com seus extremos em v1 e v2 */
+static bool arestaConstrucao(ConstrucaoCSR *cc, int i, int *v1, int *v2)
+{
+    int ordem = cc->csr->ordem;
+
+    *v1 = cc->arestas[2 * i];
+    *v2 = cc->arestas[2 * i + 1];
+    if (*v1 < 0 || *v1 >= ordem || *v2 < 0 || *v2 >= ordem) /* Testo se vertices sao validos */
+        return false;
+    return *v1 != *v2 || !(cc->opcoes & CONSTRUCAO_SEM_LACOS);
+}
+
+/* Grau de cada vertice, deslocado de uma posicao em inicio */
+static void tarefaContaGraus(void *dados, int inicio, int fim)
+{
+    ConstrucaoCSR *cc = (ConstrucaoCSR *)dados;
+    int i, v1, v2;
+
+    for (i = inicio; i < fim; i++)
+        if (arestaConstrucao(cc, i, &v1, &v2))
+        {
+            if (cc->atomico)
+            {
+                __sync_fetch_and_add(&cc->csr->inicio[v1 + 1], 1);
+                __sync_fetch_and_add(&cc->csr->inicio[v2 + 1], 1);
+            }
+            else
+            {
+                cc->csr->inicio[v1 + 1]++;
+                cc->csr->inicio[v2 + 1]++;
+            }
+        }
+}
+
+static void tarefaSomaBlocos(void *dados, int inicio, int fim)
+{
+    ConstrucaoCSR *cc = (ConstrucaoCSR *)dados;
+    int b, i, soma;
+
+    for (b = inicio; b < fim; b++)
+    {
+        soma = 0;
+        for (i = (int)((long)cc->numValores * b / cc->numBlocos); i < (int)((long)cc->numValores * (b + 1) / cc->numBlocos); i++)
+            soma += cc->valores[i];
+        cc->somaBloco[b] = soma;
+    }
+}
+
+static void tarefaAcumulaBlocos(void *dados, int inicio, int fim)
+{
+    ConstrucaoCSR *cc = (ConstrucaoCSR *)dados;
+    int b, i, soma;
+
+    for (b = inicio; b < fim; b++)
+    {
+        soma = cc->somaBloco[b];
+        for (i = (int)((long)cc->numValores * b / cc->numBlocos); i < (int)((long)cc->numValores * (b + 1) / cc->numBlocos); i++)
+        {
+            soma += cc->valores[i];
+            cc->valores[i] = soma;
+        }
+    }
+}
+
+/**
+ * Soma de prefixos inclusiva de valores[0] ate valores[n - 1], no proprio
+ * vetor, em duas passadas paralelas. Retorna a soma de todos os valores
+*/
+static int somaPrefixosParalela(ConstrucaoCSR *cc, int valores[], int n, int numThreads)
+{
+    int b, soma, total;
+
+    cc->valores = valores;
+    cc->numValores = n;
+    cc->numBlocos = numThreads > 1 ? numThreads : 1;
+    cc->somaBloco = (int *)malloc(sizeof(int) * cc->numBlocos);
+
+    executaEmParalelo(tarefaSomaBlocos, cc, cc->numBlocos, numThreads);
+    total = 0;
+    for (b = 0; b < cc->numBlocos; b++)
+    {
+        soma = cc->somaBloco[b];
+        cc->somaBloco[b] = total;
+        total += soma;
+    }
+    executaEmParalelo(tarefaAcumulaBlocos, cc, cc->numBlocos, numThreads);
+
+    free(cc->somaBloco);
+    return total;
+}
+
+/* Cada extremo reserva uma posicao na lista do outro */
+static void tarefaEspalhaArestas(void *dados, int inicio, int fim)
+{
+    ConstrucaoCSR *cc = (ConstrucaoCSR *)dados;
+    int *vizinhos = cc->csr->vizinhos;
+    int i, v1, v2;
+
+    for (i = inicio; i < fim; i++)
+        if (arestaConstrucao(cc, i, &v1, &v2))
+        {
+            if (cc->atomico)
+            {
+                vizinhos[__sync_fetch_and_add(&cc->posicao[v1], 1)] = v2;
+                vizinhos[__sync_fetch_and_add(&cc->posicao[v2], 1)] = v1;
+            }
+            else
+            {
+                vizinhos[cc->posicao[v1]++] = v2;
+                vizinhos[cc->posicao[v2]++] = v1;
+            }
+        }
+}
+
+/**
+ * Quicksort com pivo pela mediana de tres, sem o custo de uma chamada de
+ * funcao por comparacao do qsort. So a parte menor e ordenada por recursao,
+ * entao a profundidade fica limitada a log n
+*/
+static void ordenaVizinhos(int vizinhos[], int n)
+{
+    int a, b, c, pivo, i, j, x;
+
+    while (n > VIZINHOS_ORDENACAO_SIMPLES)
+    {
+        a = vizinhos[0];
+        b = vizinhos[n / 2];
+        c = vizinhos[n - 1];
+        pivo = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+        i = 0;
+        j = n - 1;
+        while (i <= j)
+        {
+            while (vizinhos[i] < pivo)
+                i++;
+            while (vizinhos[j] > pivo)
+                j--;
+            if (i <= j)
+            {
+                x = vizinhos[i];
+                vizinhos[i++] = vizinhos[j];
+                vizinhos[j--] = x;
+            }
+        }
+
+        /*Partes: vizinhos[0..j] e vizinhos[i..n - 1]*/
+        if (j + 1 < n - i)
+        {
+            ordenaVizinhos(vizinhos, j + 1);
+            vizinhos += i;
+            n -= i;
+        }
+        else
+        {
+            ordenaVizinhos(vizinhos + i, n - i);
+            n = j + 1;
+        }
+    }
+
+    for (i = 1; i < n; i++)
+    {
+        x = vizinhos[i];
+        for (j = i; j > 0 && vizinhos[j - 1] > x; j--)
+            vizinhos[j] = vizinhos[j - 1];
+        vizinhos[j] = x;
+    }
+}
+
+/**
+ * Ordena a lista de cada vertice e, sem repetidas, compacta a lista no
+ * comeco do seu proprio espaco, guardando o novo grau deslocado de uma
+ * posicao, pronto para a soma de prefixos
+*/
+static void tarefaOrdenaVizinhos(void *dados, int inicio, int fim)
+{
+    ConstrucaoCSR *cc = (ConstrucaoCSR *)dados;
+    GrafoCSR *csr = cc->csr;
+    int *lista;
+    int v, i, n, unicos;
+
+    for (v = inicio; v < fim; v++)
+    {
+        lista = &csr->vizinhos[csr->inicio[v]];
+        n = csr->inicio[v + 1] - csr->inicio[v];
+        ordenaVizinhos(lista, n);
+
+        if (!(cc->opcoes & CONSTRUCAO_SEM_REPETIDAS))
+            continue;
+        unicos = n > 0 ? 1 : 0;
+        for (i = 1; i < n; i++)
+            if (lista[i] != lista[unicos - 1])
+                lista[unicos++] = lista[i];
+        cc->grau[v + 1] = unicos;
+    }
+}
+
+static void tarefaCopiaVizinhos(void *dados, int inicio, int fim)
+{
+    ConstrucaoCSR *cc = (ConstrucaoCSR *)dados;
+    int v;
+
+    for (v = inicio; v < fim; v++)
+        memcpy(&cc->vizinhosNovo[cc->grau[v]], &cc->csr->vizinhos[cc->csr->inicio[v]],
+               sizeof(int) * (cc->grau[v + 1] - cc->grau[v]));
+}
+
+/**
+ * Cria um grafo CSR de uma lista de arestas (no formato de criaGrafoCSRArestas)
+ * usando numThreads threads em todas as etapas: contagem dos graus, soma de
+ * prefixos, distribuicao das arestas nas listas e, conforme as opcoes,
+ * ordenacao das listas, remocao de repetidas e de lacos.
+ * 
+ * Sem CONSTRUCAO_ORDENADA, a ordem dos vizinhos depende de como as threads
+ * se intercalaram. Um laco mantido aparece duas vezes na lista do vertice,
+ * como em acrescentaAresta
+*/
+GrafoCSR *criaGrafoCSRParalelo(int ordem, int arestas[], int numArestas, int opcoes, int numThreads)
+{
+    ConstrucaoCSR cc;
+    GrafoCSR *csr;
+    int total;
+
+    if (opcoes & CONSTRUCAO_SEM_REPETIDAS)
+        opcoes |= CONSTRUCAO_ORDENADA;
+
+    csr = alocaGrafoCSR(ordem, 0);
+    cc.csr = csr;
+    cc.arestas = arestas;
+    cc.numArestas = numArestas;
+    cc.opcoes = opcoes;
+#ifdef BUSCA_PARALELA
+    cc.atomico = numThreads > 1;
+#else
+    cc.atomico = false;
+#endif
+
+    executaEmParalelo(tarefaContaGraus, &cc, numArestas, numThreads);
+    total = somaPrefixosParalela(&cc, &csr->inicio[1], ordem, numThreads);
+
+    free(csr->vizinhos);
+    csr->numSemiArestas = total;
+    csr->vizinhos = (int *)malloc(sizeof(int) * (total > 0 ? total : 1));
+
+    cc.posicao = (int *)malloc(sizeof(int) * (ordem > 0 ? ordem : 1));
+    memcpy(cc.posicao, csr->inicio, sizeof(int) * ordem);
+    executaEmParalelo(tarefaEspalhaArestas, &cc, numArestas, numThreads);
+    free(cc.posicao);
+
+    if (!(opcoes & CONSTRUCAO_ORDENADA))
+        return csr;
+
+    cc.grau = (opcoes & CONSTRUCAO_SEM_REPETIDAS) ? (int *)calloc(ordem + 1, sizeof(int)) : NULL;
+    executaEmParalelo(tarefaOrdenaVizinhos, &cc, ordem, numThreads);
+    if (cc.grau == NULL)
+        return csr;
+
+    /*Listas compactadas em um novo vetor, com os inicios dados pelos novos graus*/
+    total = somaPrefixosParalela(&cc, &cc.grau[1], ordem, numThreads);
+    cc.vizinhosNovo = (int *)malloc(sizeof(int) * (total > 0 ? total : 1));
+    executaEmParalelo(tarefaCopiaVizinhos, &cc, ordem, numThreads);
+
+    free(csr->vizinhos);
+    free(csr->inicio);
+    csr->vizinhos = cc.vizinhosNovo;
+    csr->inicio = cc.grau;
+    csr->numSemiArestas = total;
+
+    return csr;
+}
+
+/*
+ * Implementacao da reordenacao dos vertices
+ */
+
+/* Vertice e a chave pela qual ele e ordenado (o grau) */
+typedef struct verticeChave
+{
+    int chave;
+    int vertice;
+} VerticeChave;
+
+/* Chave crescente; empates pelo nome, para que a ordem seja sempre a mesma */
+static int comparaChaveCrescente(const void *a, const void *b)
+{
+    const VerticeChave *x = (const VerticeChave *)a;
+    const VerticeChave *y = (const VerticeChave *)b;
+
+    if (x->chave != y->chave)
+        return (x->chave > y->chave) - (x->chave < y->chave);
+    return (x->vertice > y->vertice) - (x->vertice < y->vertice);
+}
+
+static int comparaChaveDecrescente(const void *a, const void *b)
+{
+    const VerticeChave *x = (const VerticeChave *)a;
+    const VerticeChave *y = (const VerticeChave *)b;
+
+    if (x->chave != y->chave)
+        return (x->chave < y->chave) - (x->chave > y->chave);
+    return (x->vertice > y->vertice) - (x->vertice < y->vertice);
+}
+
+/* Grau de v, escrito em fila[fim] como chave */
+static void enfileiraComGrau(GrafoCSR *csr, VerticeChave fila[], int fim, int v)
+{
+    fila[fim].vertice = v;
+    fila[fim].chave = csr->inicio[v + 1] - csr->inicio[v];
+}
+
+/**
+ * Busca em largura por todas as componentes, escrevendo em ordem os
+ * vertices descobertos. Cada componente comeca pelo primeiro vertice
+ * ainda nao visitado de inicios. Com porGrau, os vizinhos descobertos
+ * por um vertice entram na fila em ordem crescente de grau (Cuthill-McKee)
+*/
+static void ordemBuscaLargura(GrafoCSR *csr, int inicios[], bool porGrau, int ordem[])
+{
+    PalavraBits *visitados = (PalavraBits *)calloc(PALAVRAS_MAPA_BITS(csr->ordem) + 1, sizeof(PalavraBits));
+    VerticeChave *fila = (VerticeChave *)malloc(sizeof(VerticeChave) * (csr->ordem > 0 ? csr->ordem : 1));
+    int i, j, inicio, fim, fimAnterior, u, w;
+
+    inicio = fim = 0;
+    for (i = 0; i < csr->ordem; i++)
+    {
+        if (TESTA_BIT(visitados, inicios[i]))
+            continue;
+
+        MARCA_BIT(visitados, inicios[i]);
+        enfileiraComGrau(csr, fila, fim++, inicios[i]);
+
+        while (inicio < fim)
+        {
+            u = fila[inicio++].vertice;
+            fimAnterior = fim;
+            for (j = csr->inicio[u]; j < csr->inicio[u + 1]; j++)
+            {
+                w = csr->vizinhos[j];
+                if (!TESTA_BIT(visitados, w))
+                {
+                    MARCA_BIT(visitados, w);
+                    enfileiraComGrau(csr, fila, fim++, w);
+                }
+            }
+            if (porGrau)
+                qsort(&fila[fimAnterior], fim - fimAnterior, sizeof(VerticeChave), comparaChaveCrescente);
+        }
+    }
+
+    for (i = 0; i < csr->ordem; i++)
+        ordem[i] = fila[i].vertice;
+
+    free(fila);
+    free(visitados);
+}
+
+/**
+ * Calcula uma nova ordem dos vertices pelo metodo escolhido:
+ * 
+ * REORDENACAO_RCM: busca em largura em cada componente a partir do vertice
+ * de menor grau, com os vizinhos em ordem crescente de grau, e a ordem final
+ * invertida. Vizinhos recebem nomes proximos, e as listas ficam estreitas.
+ * REORDENACAO_GRAU: vertices em ordem decrescente de grau. Os de grau alto,
+ * visitados por quase todas as buscas, ficam juntos no comeco dos vetores.
+ * REORDENACAO_LARGURA: ordem de descoberta de uma busca em largura a partir
+ * de cada vertice ainda nao visitado, em ordem de nome.
+ * 
+ * Retorna NULL se o metodo for desconhecido
+*/
+Reordenacao *calculaReordenacaoCSR(GrafoCSR *csr, int metodo)
+{
+    Reordenacao *reordenacao;
+    VerticeChave *vertices;
+    int *inicios;
+    int tamanho = csr->ordem > 0 ? csr->ordem : 1;
+    int v, x;
+
+    if (metodo != REORDENACAO_RCM && metodo != REORDENACAO_GRAU && metodo != REORDENACAO_LARGURA)
+        return NULL;
+
+    reordenacao = (Reordenacao *)malloc(sizeof(Reordenacao));
+    reordenacao->ordem = csr->ordem;
+    reordenacao->novoNome = (int *)malloc(sizeof(int) * tamanho);
+    reordenacao->nomeOriginal = (int *)malloc(sizeof(int) * tamanho);
+
+    if (metodo == REORDENACAO_LARGURA)
+    {
+        inicios = (int *)malloc(sizeof(int) * tamanho);
+        for (v = 0; v < csr->ordem; v++)
+            inicios[v] = v;
+        ordemBuscaLargura(csr, inicios, false, reordenacao->nomeOriginal);
+        free(inicios);
+    }
+    else
+    {
+        vertices = (VerticeChave *)malloc(sizeof(VerticeChave) * tamanho);
+        for (v = 0; v < csr->ordem; v++)
+            enfileiraComGrau(csr, vertices, v, v);
+        qsort(vertices, csr->ordem, sizeof(VerticeChave),
+              metodo == REORDENACAO_GRAU ? comparaChaveDecrescente : comparaChaveCrescente);
+
+        if (metodo == REORDENACAO_GRAU)
+            for (v = 0; v < csr->ordem; v++)
+                reordenacao->nomeOriginal[v] = vertices[v].vertice;
+        else
+        {
+            /*Cada componente comeca pelo seu vertice de menor grau*/
+            inicios = (int *)malloc(sizeof(int) * tamanho);
+            for (v = 0; v < csr->ordem; v++)
+                inicios[v] = vertices[v].vertice;
+            ordemBuscaLargura(csr, inicios, true, reordenacao->nomeOriginal);
+            free(inicios);
+
+            for (v = 0; v < csr->ordem / 2; v++)
+            {
+                x = reordenacao->nomeOriginal[v];
+                reordenacao->nomeOriginal[v] = reordenacao->nomeOriginal[csr->ordem - 1 - v];
+                reordenacao->nomeOriginal[csr->ordem - 1 - v] = x;
+            }
+        }
+        free(vertices);
+    }
+
+    for (v = 0; v < csr->ordem; v++)
+        reordenacao->novoNome[reordenacao->nomeOriginal[v]] = v;
+
+    return reordenacao;
+}
+
+void liberaReordenacao(Reordenacao *reordenacao)
+{
+    free(reordenacao->novoNome);
+    free(reordenacao->nomeOriginal);
+    free(reordenacao);
+}
+
+/* Grafos de origem e destino da copia paralela das listas renomeadas */
+typedef struct copiaReordenada
+{
+    GrafoCSR *origem;
+    GrafoCSR *destino;
+    Reordenacao *reordenacao;
+} CopiaReordenada;
+
+static void tarefaCopiaReordenada(void *dados, int inicio, int fim)
+{
+    CopiaReordenada *copia = (CopiaReordenada *)dados;
+    GrafoCSR *origem = copia->origem, *destino = copia->destino;
+    int v, u, j, k;
+
+    for (v = inicio; v < fim; v++)
+    {
+        u = copia->reordenacao->nomeOriginal[v];
+        k = destino->inicio[v];
+        for (j = origem->inicio[u]; j < origem->inicio[u + 1]; j++)
+            destino->vizinhos[k++] = copia->reordenacao->novoNome[origem->vizinhos[j]];
+        ordenaVizinhos(&destino->vizinhos[destino->inicio[v]], k - destino->inicio[v]);
+    }
+}
+
+/**
+ * Cria o grafo CSR com os vertices renomeados pela reordenacao.
+ * Cada lista de vizinhos fica em ordem crescente dos novos nomes,
+ * para que as buscas percorram os vetores de resultado em sequencia
+*/
+GrafoCSR *reordenaGrafoCSR(GrafoCSR *csr, Reordenacao *reordenacao, int numThreads)
+{
+    CopiaReordenada copia;
+    GrafoCSR *reordenado = alocaGrafoCSR(csr->ordem, csr->numSemiArestas);
+    int v, u;
+
+    for (v = 0; v < csr->ordem; v++)
+    {
+        u = reordenacao->nomeOriginal[v];
+        reordenado->inicio[v + 1] = reordenado->inicio[v] + csr->inicio[u + 1] - csr->inicio[u];
+    }
+
+    copia.origem = csr;
+    copia.destino = reordenado;
+    copia.reordenacao = reordenacao;
+    executaEmParalelo(tarefaCopiaReordenada, &copia, csr->ordem, numThreads);
+
+    return reordenado;
+}
+
+/**
+ * Traz um vetor indexado pelos novos nomes (resultado de uma busca sobre o
+ * grafo reordenado) para os nomes originais. Com valoresSaoVertices, os
+ * valores tambem sao nomes de vertices (pai, componente), e sao traduzidos;
+ * ELEMENTO_NAO_DEFINIDO e mantido
+*/
+void traduzVetorReordenado(Reordenacao *reordenacao, int vetor[], bool valoresSaoVertices)
+{
+    int *copia = (int *)malloc(sizeof(int) * (reordenacao->ordem > 0 ? reordenacao->ordem : 1));
+    int v, x;
+
+    memcpy(copia, vetor, sizeof(int) * reordenacao->ordem);
+    for (v = 0; v < reordenacao->ordem; v++)
+    {
+        x = copia[v];
+        if (valoresSaoVertices && x >= 0 && x < reordenacao->ordem)
+            x = reordenacao->nomeOriginal[x];
+        vetor[reordenacao->nomeOriginal[v]] = x;
+    }
+
+    free(copia);
+}
+
+static void traduzMapaBits(Reordenacao *reordenacao, PalavraBits mapa[])
+{
+    int palavras = PALAVRAS_MAPA_BITS(reordenacao->ordem);
+    PalavraBits *copia = (PalavraBits *)malloc(sizeof(PalavraBits) * (palavras + 1));
+    int v;
+
+    memcpy(copia, mapa, sizeof(PalavraBits) * palavras);
+    memset(mapa, 0, sizeof(PalavraBits) * palavras);
+    for (v = 0; v < reordenacao->ordem; v++)
+        if (TESTA_BIT(copia, v))
+            MARCA_BIT(mapa, reordenacao->nomeOriginal[v]);
+
+    free(copia);
+}
+
+void traduzResultadoBuscaLargura(Reordenacao *reordenacao, ResultadoBuscaLargura *resultado)
+{
+    traduzVetorReordenado(reordenacao, resultado->pai, true);
+    traduzVetorReordenado(reordenacao, resultado->distancia, false);
+    traduzMapaBits(reordenacao, resultado->visitados);
+}
+
+/**
+ * As componentes continuam com o nome de um de seus vertices, mas nao
+ * necessariamente o menor nome original, como em buscaProfundida
+*/
+void traduzResultadoBuscaProfundidade(Reordenacao *reordenacao, ResultadoBuscaProfundidade *resultado)
+{
+    traduzVetorReordenado(reordenacao, resultado->pai, true);
+    traduzVetorReordenado(reordenacao, resultado->tempoDescoberta, false);
+    traduzVetorReordenado(reordenacao, resultado->tempoFinalizacao, false);
+    traduzVetorReordenado(reordenacao, resultado->componente, true);
+    traduzMapaBits(reordenacao, resultado->visitados);
+}
+
+/*
+ * Implementacao do grafo comprimido
+ */
+
+/**
+ * Leitura sequencial de uma lista de vizinhos comprimida: a cada chamada
+ * de proximoVizinho, vizinho passa a ser o proximo vizinho da lista
+*/
+typedef struct iteradorVizinhos
+{
+    const unsigned char *inicio; /* comeco da lista: o primeiro vizinho tem sinal */
+    const unsigned char *atual;
+    const unsigned char *fim;
+    int vizinho; /* antes do primeiro, o proprio vertice */
+} IteradorVizinhos;
+
+static void iniciaIteradorVizinhos(GrafoComprimido *comprimido, int v, IteradorVizinhos *iterador)
+{
+    iterador->inicio = comprimido->bytes + comprimido->inicio[v];
+    iterador->atual = iterador->inicio;
+    iterador->fim = comprimido->bytes + comprimido->inicio[v + 1];
+    iterador->vizinho = v;
+}
+
+static bool proximoVizinho(IteradorVizinhos *iterador)
+{
+    unsigned int valor = 0;
+    int deslocamento = 0;
+    bool primeiro = iterador->atual == iterador->inicio;
+
+    if (iterador->atual == iterador->fim)
+        return false;
+
+    do
+    {
+        valor |= (unsigned int)(*iterador->atual & 0x7f) << deslocamento;
+        deslocamento += 7;
+    } while (*iterador->atual++ & 0x80);
+
+    if (!primeiro)
+        iterador->vizinho += (int)valor;
+    else if (valor & 1)
+        iterador->vizinho -= (int)((valor + 1) / 2);
+    else
+        iterador->vizinho += (int)(valor / 2);
+    return true;
+}
+
+/* Escreve valor em bytes (se nao for NULL) e retorna quantos bytes ele ocupa */
+static int escreveInteiroVariavel(unsigned char *bytes, unsigned int valor)
+{
+    int n = 0;
+
+    do
+    {
+        if (bytes != NULL)
+            bytes[n] = (unsigned char)((valor & 0x7f) | (valor >= 0x80 ? 0x80 : 0));
+        n++;
+        valor >>= 7;
+    } while (valor != 0);
+
+    return n;
+}
+
+/**
+ * Codifica a lista ordenada de v (com n vizinhos) em bytes, se nao for
+ * NULL, e retorna o tamanho da lista codificada
+*/
+static size_t codificaVizinhos(unsigned char *bytes, int v, int vizinhos[], int n)
+{
+    size_t tamanho;
+    int i, diferenca;
+
+    if (n == 0)
+        return 0;
+
+    diferenca = vizinhos[0] - v;
+    tamanho = escreveInteiroVariavel(bytes, diferenca >= 0 ? 2u * (unsigned int)diferenca
+                                                           : 2u * (unsigned int)(-diferenca) - 1);
+    for (i = 1; i < n; i++)
+        tamanho += escreveInteiroVariavel(bytes != NULL ? bytes + tamanho : NULL,
+                                          (unsigned int)(vizinhos[i] - vizinhos[i - 1]));
+    return tamanho;
+}
+
+typedef struct compressaoGrafo
+{
+    GrafoCSR *csr;
+    GrafoComprimido *comprimido;
+    bool escreve; /* falso: apenas mede o tamanho de cada lista */
+} CompressaoGrafo;
+
+/**
+ * Ordena uma copia da lista de cada vertice (o grafo CSR pode estar mapeado
+ * de um arquivo) e mede ou escreve a lista codificada. Na medicao, o tamanho
+ * da lista de v fica em inicio[v + 1], pronto para a soma de prefixos
+*/
+static void tarefaComprimeVizinhos(void *dados, int inicio, int fim)
+{
+    CompressaoGrafo *compressao = (CompressaoGrafo *)dados;
+    GrafoCSR *csr = compressao->csr;
+    GrafoComprimido *comprimido = compressao->comprimido;
+    int *lista;
+    int v, grau, maiorGrau;
+
+    maiorGrau = 1;
+    for (v = inicio; v < fim; v++)
+        if (csr->inicio[v + 1] - csr->inicio[v] > maiorGrau)
+            maiorGrau = csr->inicio[v + 1] - csr->inicio[v];
+    lista = (int *)malloc(sizeof(int) * maiorGrau);
+
+    for (v = inicio; v < fim; v++)
+    {
+        grau = csr->inicio[v + 1] - csr->inicio[v];
+        memcpy(lista, &csr->vizinhos[csr->inicio[v]], sizeof(int) * grau);
+        ordenaVizinhos(lista, grau);
+
+        if (compressao->escreve)
+            codificaVizinhos(comprimido->bytes + comprimido->inicio[v], v, lista, grau);
+        else
+            comprimido->inicio[v + 1] = codificaVizinhos(NULL, v, lista, grau);
+    }
+
+    free(lista);
+}
+
+/**
+ * Cria a forma comprimida de um grafo CSR, em duas passadas paralelas:
+ * a primeira mede cada lista codificada e a segunda a escreve. O grafo
+ * CSR pode ser liberado em seguida
+*/
+GrafoComprimido *comprimeGrafoCSR(GrafoCSR *csr, int numThreads)
+{
+    GrafoComprimido *comprimido = (GrafoComprimido *)malloc(sizeof(GrafoComprimido));
+    CompressaoGrafo compressao;
+    int v;
+
+    comprimido->ordem = csr->ordem;
+    comprimido->numSemiArestas = csr->numSemiArestas;
+    comprimido->inicio = (size_t *)calloc(csr->ordem + 1, sizeof(size_t));
+
+    compressao.csr = csr;
+    compressao.comprimido = comprimido;
+    compressao.escreve = false;
+    executaEmParalelo(tarefaComprimeVizinhos, &compressao, csr->ordem, numThreads);
+
+    for (v = 0; v < csr->ordem; v++)
+        comprimido->inicio[v + 1] += comprimido->inicio[v];
+
+    comprimido->bytes = (unsigned char *)malloc(comprimido->inicio[csr->ordem] > 0 ? comprimido->inicio[csr->ordem] : 1);
+    compressao.escreve = true;
+    executaEmParalelo(tarefaComprimeVizinhos, &compressao, csr->ordem, numThreads);
+
+    return comprimido;
+}
+
+void liberaGrafoComprimido(GrafoComprimido *comprimido)
+{
+    free(comprimido->inicio);
+    free(comprimido->bytes);
+    free(comprimido);
+}
+
+/* Memoria ocupada pelo grafo comprimido, em bytes */
+size_t memoriaGrafoComprimido(GrafoComprimido *comprimido)
+{
+    return sizeof(GrafoComprimido) + sizeof(size_t) * (comprimido->ordem + 1) + comprimido->inicio[comprimido->ordem];
+}
+
+/**
+ * Mesma busca de buscaLarguraCSR, decodificando a lista de cada vertice
+ * retirado da fila
+*/
+void buscaLarguraComprimido(GrafoComprimido *comprimido, int verticeInicial, ResultadoBuscaLargura *resultado)
+{
+    IteradorVizinhos iterador;
+    Fila *Q;
+    int *distancia = resultado->distancia;
+    int *pai = resultado->pai;
+    PalavraBits *visitados = resultado->visitados;
+    int u, w;
+
+    iniciaResultadoBuscaLargura(resultado);
+
+    if (verticeInicial < 0 || verticeInicial >= comprimido->ordem) /* Testo se vertice e valido */
+        return;
+
+    MARCA_BIT(visitados, verticeInicial);
+    distancia[verticeInicial] = 0;
+    REGISTRA_FRONTEIRA(0, 1);
+
+    Q = inicializaFila(comprimido->ordem);
+    enfileira(Q, verticeInicial);
+
+    while (!filaEstaVazia(Q))
+    {
+        u = desinfileira(Q);
+
+        iniciaIteradorVizinhos(comprimido, u, &iterador);
+        while (proximoVizinho(&iterador))
+        {
+            w = iterador.vizinho;
+            CONTA_ARESTAS(1);
+            if (!TESTA_BIT(visitados, w))
+            {
+                MARCA_BIT(visitados, w);
+                distancia[w] = distancia[u] + 1;
+                pai[w] = u;
+                REGISTRA_FRONTEIRA(distancia[w], 1);
+
+                enfileira(Q, w);
+            }
+        }
+    }
+
+    liberaFila(Q);
+}
+
+/**
+ * Mesma busca de buscaProfundidaCSR. Cada item da pilha guarda a posicao
+ * em bytes do proximo vizinho e o ultimo vizinho lido, de onde a leitura
+ * da lista continua quando a busca volta ao vertice
+*/
+void buscaProfundidaComprimido(GrafoComprimido *comprimido, ResultadoBuscaProfundidade *resultado)
+{
+    IteradorVizinhos iterador;
+    Pilha *pilha;
+    ItemPilha *item;
+    int tempo, raiz, w;
+    bool encontrado;
+
+    iniciaResultadoBuscaProfundidade(resultado);
+    pilha = inicializaPilha(comprimido->ordem);
+
+    tempo = 0;
+    for (raiz = 0; raiz < comprimido->ordem; raiz++)
+    {
+        if (TESTA_BIT(resultado->visitados, raiz))
+            continue;
+
+        descobreVertice(resultado, raiz, &tempo, raiz);
+        item = empilha(pilha, raiz);
+        item->proximo.comprimido.byte = comprimido->inicio[raiz];
+        item->proximo.comprimido.anterior = raiz;
+
+        while (!pilhaEstaVazia(pilha))
+        {
+            item = topoPilha(pilha);
+
+            iniciaIteradorVizinhos(comprimido, item->vertice, &iterador);
+            iterador.atual = comprimido->bytes + item->proximo.comprimido.byte;
+            iterador.vizinho = item->proximo.comprimido.anterior;
+
+            encontrado = false;
+            while (!encontrado && proximoVizinho(&iterador))
+            {
+                CONTA_ARESTAS(1);
+                encontrado = !TESTA_BIT(resultado->visitados, iterador.vizinho);
+            }
+
+            if (!encontrado)
+            {
+                finalizaVertice(resultado, item->vertice, &tempo);
+                desempilha(pilha);
+                continue;
+            }
+
+            item->proximo.comprimido.byte = iterador.atual - comprimido->bytes;
+            item->proximo.comprimido.anterior = iterador.vizinho;
+
+            w = iterador.vizinho;
+            resultado->pai[w] = item->vertice;
+            descobreVertice(resultado, w, &tempo, raiz);
+            item = empilha(pilha, w);
+            item->proximo.comprimido.byte = comprimido->inicio[w];
+            item->proximo.comprimido.anterior = w;
+        }
+    }
+
+    liberaPilha(pilha);
+}
+
+/* Liga cada vertice aos vizinhos de menor nome: as listas sao ordenadas */
+static void tarefaLigaComprimido(void *dados, int inicio, int fim)
+{
+    ComponentesParalelo *cp = (ComponentesParalelo *)dados;
+    IteradorVizinhos iterador;
+    int v;
+
+    for (v = inicio; v < fim; v++)
+    {
+        iniciaIteradorVizinhos(cp->comprimido, v, &iterador);
+        while (proximoVizinho(&iterador) && iterador.vizinho < v)
+            ligaComponentes(cp->comp, v, iterador.vizinho);
+    }
+}
+
+/**
+ * Componentes conexas do grafo comprimido, com as mesmas ligacoes sem travas
+ * de definirComponentesParaleloCSR, mas lendo cada aresta uma unica vez
+ * (do extremo de maior nome). Cada componente recebe o nome do seu menor vertice
+*/
+void definirComponentesComprimido(GrafoComprimido *comprimido, int componente[], int numThreads)
+{
+    ComponentesParalelo cp;
+
+    cp.csr = NULL;
+    cp.comprimido = comprimido;
+    cp.comp = componente;
+
+    executaEmParalelo(tarefaIniciaComponentes, &cp, comprimido->ordem, numThreads);
+    executaEmParalelo(tarefaLigaComprimido, &cp, comprimido->ordem, numThreads);
+    executaEmParalelo(tarefaCompactaComponentes, &cp, comprimido->ordem, numThreads);
+}
+
+/*
+ * Implementacao da matriz de bits
+ */
+
+#define LINHA_DENSO(denso, v) (&(denso)->matriz[(size_t)(v) * (denso)->palavrasLinha])
+
+static GrafoDenso *alocaGrafoDenso(int ordem)
+{
+    GrafoDenso *denso = (GrafoDenso *)malloc(sizeof(GrafoDenso));
+
+    denso->ordem = ordem;
+    denso->palavrasLinha = PALAVRAS_MAPA_BITS(ordem);
+    denso->matriz = (PalavraBits *)calloc((size_t)ordem * denso->palavrasLinha + 1, sizeof(PalavraBits));
+
+    return denso;
+}
+
+/* Matriz de bits de um grafo representado por listas de adjacencia */
+GrafoDenso *criaGrafoDenso(Vertice G[], int ordem)
+{
+    GrafoDenso *denso = alocaGrafoDenso(ordem);
+    Aresta *aux;
+    int v;
+
+    for (v = 0; v < ordem; v++)
+        for (aux = G[v].prim; aux != NULL; aux = aux->prox)
+            if (aux->nome != v)
+                MARCA_BIT(LINHA_DENSO(denso, v), aux->nome);
+
+    return denso;
+}
+
+typedef struct construcaoDensa
+{
+    GrafoDenso *denso;
+    int *arestas;
+    bool atomico; /* mais de uma thread marcando bits na matriz */
+} ConstrucaoDensa;
+
+static void tarefaMarcaArestasDenso(void *dados, int inicio, int fim)
+{
+    ConstrucaoDensa *cd = (ConstrucaoDensa *)dados;
+    GrafoDenso *denso = cd->denso;
+    int i, v1, v2;
+
+    for (i = inicio; i < fim; i++)
+    {
+        v1 = cd->arestas[2 * i];
+        v2 = cd->arestas[2 * i + 1];
+        if (v1 < 0 || v1 >= denso->ordem || v2 < 0 || v2 >= denso->ordem || v1 == v2) /* Testo se vertices sao validos */
+            continue;
+
+        if (cd->atomico)
+        {
+            marcaBitAtomico(LINHA_DENSO(denso, v1), v2);
+            marcaBitAtomico(LINHA_DENSO(denso, v2), v1);
+        }
+        else
+        {
+            MARCA_BIT(LINHA_DENSO(denso, v1), v2);
+            MARCA_BIT(LINHA_DENSO(denso, v2), v1);
+        }
+    }
+}
+
+/* Matriz de bits de uma lista de arestas, no formato de criaGrafoCSRArestas */
+GrafoDenso *criaGrafoDensoArestas(int ordem, int arestas[], int numArestas, int numThreads)
+{
+    ConstrucaoDensa cd;
+
+    cd.denso = alocaGrafoDenso(ordem);
+    cd.arestas = arestas;
+#ifdef BUSCA_PARALELA
+    cd.atomico = numThreads > 1;
+#else
+    cd.atomico = false;
+#endif
+    executaEmParalelo(tarefaMarcaArestasDenso, &cd, numArestas, numThreads);
+
+    return cd.denso;
+}
+
+void liberaGrafoDenso(GrafoDenso *denso)
+{
+    free(denso->matriz);
+    free(denso);
+}
+
+/* Cada aresta e um bit em duas linhas: o tamanho sai da contagem de bits */
+int calculaTamanhoDenso(GrafoDenso *denso)
+{
+    size_t i, total = (size_t)denso->ordem * denso->palavrasLinha;
+    long bits = 0;
+
+    for (i = 0; i < total; i++)
+        bits += __builtin_popcount(denso->matriz[i]);
+
+    return (int)(bits / 2) + denso->ordem;
+}
+
+/**
+ * Expande um nivel da busca sobre a matriz de bits, palavra a palavra:
+ * proxima recebe a uniao das linhas dos vertices da fronteira, menos os
+ * ja visitados, que passam a incluir os novos. Com AVX2 (make SIMD=1),
+ * o OR das linhas e o AND NOT com os visitados tratam 8 palavras por
+ * instrucao; sem AVX2, e o mesmo laco uma palavra por vez.
+ * Retorna o numero de novos vertices
+*/
+static int expandeFronteiraDenso(GrafoDenso *denso, PalavraBits fronteira[], PalavraBits proxima[],
+                                 PalavraBits visitados[])
+{
+    PalavraBits *linha;
+    PalavraBits palavra;
+    int palavras = denso->palavrasLinha;
+    int novos, u, k, j;
+#ifdef __AVX2__
+    __m256i p, v;
+#endif
+
+    memset(proxima, 0, sizeof(PalavraBits) * palavras);
+    for (k = 0; k < palavras; k++)
+        for (palavra = fronteira[k]; palavra != 0; palavra &= palavra - 1)
+        {
+            u = k * BITS_POR_PALAVRA + __builtin_ctz(palavra);
+            linha = LINHA_DENSO(denso, u);
+#ifdef INSTRUMENTACAO
+            for (j = 0; j < palavras; j++)
+                CONTA_ARESTAS(__builtin_popcount(linha[j]));
+#endif
+
+            j = 0;
+#ifdef __AVX2__
+            for (; j + 8 <= palavras; j += 8)
+            {
+                p = _mm256_loadu_si256((const __m256i *)&proxima[j]);
+                p = _mm256_or_si256(p, _mm256_loadu_si256((const __m256i *)&linha[j]));
+                _mm256_storeu_si256((__m256i *)&proxima[j], p);
+            }
+#endif
+            for (; j < palavras; j++)
+                proxima[j] |= linha[j];
+        }
+
+    k = 0;
+#ifdef __AVX2__
+    for (; k + 8 <= palavras; k += 8)
+    {
+        v = _mm256_loadu_si256((const __m256i *)&visitados[k]);
+        p = _mm256_andnot_si256(v, _mm256_loadu_si256((const __m256i *)&proxima[k]));
+        _mm256_storeu_si256((__m256i *)&proxima[k], p);
+        _mm256_storeu_si256((__m256i *)&visitados[k], _mm256_or_si256(v, p));
+    }
+#endif
+    for (; k < palavras; k++)
+    {
+        proxima[k] &= ~visitados[k];
+        visitados[k] |= proxima[k];
+    }
+
+    novos = 0;
+    for (k = 0; k < palavras; k++)
+        novos += __builtin_popcount(proxima[k]);
+
+    return novos;
+}
+
+/**
+ * Busca em largura sincronizada por nivel sobre a matriz de bits. A
+ * fronteira e um mapa de bits, e o proximo nivel sai de uma vez da uniao
+ * das linhas da fronteira (expandeFronteiraDenso). O pai de cada novo
+ * vertice e o primeiro bit de linha(w) & fronteira, ou seja, o seu menor
+ * vizinho na fronteira. As distancias sao as mesmas de buscaLarguraCSR;
+ * os pais formam uma arvore de busca em largura valida, mas podem ser outros
+*/
+void buscaLarguraDenso(GrafoDenso *denso, int verticeInicial, ResultadoBuscaLargura *resultado)
+{
+    PalavraBits *visitados = resultado->visitados;
+    PalavraBits *fronteira, *proxima, *troca, *linha;
+    PalavraBits palavra, comum;
+    int tamanhoProxima, nivel, w, k, j;
+
+    iniciaResultadoBuscaLargura(resultado);
+
+    if (verticeInicial < 0 || verticeInicial >= denso->ordem) /* Testo se vertice e valido */
+        return;
+
+    fronteira = (PalavraBits *)calloc(denso->palavrasLinha, sizeof(PalavraBits));
+    proxima = (PalavraBits *)calloc(denso->palavrasLinha, sizeof(PalavraBits));
+
+    MARCA_BIT(visitados, verticeInicial);
+    MARCA_BIT(fronteira, verticeInicial);
+    resultado->distancia[verticeInicial] = 0;
+    REGISTRA_FRONTEIRA(0, 1);
+
+    for (nivel = 0;; nivel++)
+    {
+        tamanhoProxima = expandeFronteiraDenso(denso, fronteira, proxima, visitados);
+        if (tamanhoProxima == 0)
+            break;
+        REGISTRA_FRONTEIRA(nivel + 1, tamanhoProxima);
+
+        for (k = 0; k < denso->palavrasLinha; k++)
+            for (palavra = proxima[k]; palavra != 0; palavra &= palavra - 1)
+            {
+                w = k * BITS_POR_PALAVRA + __builtin_ctz(palavra);
+                resultado->distancia[w] = nivel + 1;
+
+                /*Como a matriz e simetrica, w tem ao menos um vizinho na fronteira*/
+                linha = LINHA_DENSO(denso, w);
+                for (j = 0; (comum = linha[j] & fronteira[j]) == 0; j++)
+                    ;
+                resultado->pai[w] = j * BITS_POR_PALAVRA + __builtin_ctz(comum);
+            }
+
+        troca = fronteira;
+        fronteira = proxima;
+        proxima = troca;
+    }
+
+    free(fronteira);
+    free(proxima);
+}
+
+/**
+ * Componentes conexas pela mesma expansao por niveis, a partir de cada
+ * vertice ainda nao visitado. Cada componente recebe o nome do seu menor vertice
+*/
+void definirComponentesDenso(GrafoDenso *denso, int componente[])
+{
+    PalavraBits *visitados = (PalavraBits *)calloc(denso->palavrasLinha + 1, sizeof(PalavraBits));
+    PalavraBits *fronteira = (PalavraBits *)calloc(denso->palavrasLinha + 1, sizeof(PalavraBits));
+    PalavraBits *proxima = (PalavraBits *)calloc(denso->palavrasLinha + 1, sizeof(PalavraBits));
+    PalavraBits *troca;
+    PalavraBits palavra;
+    int raiz, k;
+
+    for (raiz = 0; raiz < denso->ordem; raiz++)
+    {
+        if (TESTA_BIT(visitados, raiz))
+            continue;
+
+        MARCA_BIT(visitados, raiz);
+        memset(fronteira, 0, sizeof(PalavraBits) * denso->palavrasLinha);
+        MARCA_BIT(fronteira, raiz);
+        componente[raiz] = raiz;
+
+        while (expandeFronteiraDenso(denso, fronteira, proxima, visitados) > 0)
+        {
+            for (k = 0; k < denso->palavrasLinha; k++)
+                for (palavra = proxima[k]; palavra != 0; palavra &= palavra - 1)
+                    componente[k * BITS_POR_PALAVRA + __builtin_ctz(palavra)] = raiz;
+
+            troca = fronteira;
+            fronteira = proxima;
+            proxima = troca;
+        }
+    }
+
+    free(proxima);
+    free(fronteira);
+    free(visitados);
+}
+
+/**
+ * A matriz de bits e preferida quando ocupa no maximo a memoria do CSR:
+ * ordem^2 / 8 bytes contra 4 bytes por semi-aresta, o que acontece a
+ * partir de cerca de 1/32 de todas as arestas possiveis
+*/
+bool preferirGrafoDenso(int ordem, int numArestas)
+{
+    double bytesMatriz = (double)ordem * PALAVRAS_MAPA_BITS(ordem) * sizeof(PalavraBits);
+    double bytesCSR = (double)sizeof(int) * (ordem + 1 + 2.0 * numArestas);
+
+    return ordem > 0 && bytesMatriz <= bytesCSR;
+}
+
+/**
+ * Cria o grafo simples das arestas na representacao escolhida por
+ * preferirGrafoDenso. O CSR e criado ordenado, sem lacos nem repetidas,
+ * para que as duas representacoes tenham o mesmo tamanho e as mesmas
+ * distancias e componentes
+*/
+GrafoAutomatico *criaGrafoAutomatico(int ordem, int arestas[], int numArestas, int numThreads)
+{
+    GrafoAutomatico *grafo = (GrafoAutomatico *)malloc(sizeof(GrafoAutomatico));
+
+    grafo->ordem = ordem;
+    grafo->csr = NULL;
+    grafo->denso = NULL;
+    if (preferirGrafoDenso(ordem, numArestas))
+        grafo->denso = criaGrafoDensoArestas(ordem, arestas, numArestas, numThreads);
+    else
+        grafo->csr = criaGrafoCSRParalelo(ordem, arestas, numArestas,
+                                          CONSTRUCAO_SEM_REPETIDAS | CONSTRUCAO_SEM_LACOS, numThreads);
+
+    return grafo;
+}
+
+void liberaGrafoAutomatico(GrafoAutomatico *grafo)
+{
+    if (grafo->denso != NULL)
+        liberaGrafoDenso(grafo->denso);
+    else
+        liberaGrafoCSR(grafo->csr);
+    free(grafo);
+}
+
+int calculaTamanhoAutomatico(GrafoAutomatico *grafo)
+{
+    if (grafo->denso != NULL)
+        return calculaTamanhoDenso(grafo->denso);
+    return calculaTamanhoCSR(grafo->csr);
+}
+
+void buscaLarguraAutomatico(GrafoAutomatico *grafo, int verticeInicial, ResultadoBuscaLargura *resultado)
+{
+    if (grafo->denso != NULL)
+        buscaLarguraDenso(grafo->denso, verticeInicial, resultado);
+    else
+        buscaLarguraCSR(grafo->csr, verticeInicial, resultado);
+}
+
+void definirComponentesAutomatico(GrafoAutomatico *grafo, int componente[], int numThreads)
+{
+    if (grafo->denso != NULL)
+        definirComponentesDenso(grafo->denso, componente);
+    else
+        definirComponentesParaleloCSR(grafo->csr, componente, numThreads);
+}
+
+/**
+ * Reserva o resultado de uma busca com numFontes fontes. A matriz de
+ * distancias tem numFontes x ordem inteiros, calculados em size_t.
+ * Retorna NULL se ela nao cabe na memoria enderecavel ou nao pode ser reservada
+*/
+ResultadoBuscaMultipla *criaResultadoBuscaMultipla(int ordem, int numFontes, bool guardaDistancias)
+{
+    ResultadoBuscaMultipla *resultado;
+    size_t tamanho = numFontes > 0 ? (size_t)numFontes : 1;
+    size_t colunas = ordem > 0 ? (size_t)ordem : 1;
+    int *distancia = NULL;
+
+    if (guardaDistancias)
+    {
+        if (tamanho > (size_t)-1 / sizeof(int) / colunas)
+            return NULL;
+        distancia = (int *)malloc(sizeof(int) * tamanho * colunas);
+        if (distancia == NULL)
+            return NULL;
+    }
+
+    resultado = (ResultadoBuscaMultipla *)malloc(sizeof(ResultadoBuscaMultipla));
+    resultado->ordem = ordem;
+    resultado->numFontes = numFontes;
+    resultado->distancia = distancia;
+    resultado->alcancados = (int *)malloc(sizeof(int) * tamanho);
+    resultado->excentricidade = (int *)malloc(sizeof(int) * tamanho);
+    resultado->somaDistancias = (unsigned long *)malloc(sizeof(unsigned long) * tamanho);
+
+    return resultado;
+}
+
+void liberaResultadoBuscaMultipla(ResultadoBuscaMultipla *resultado)
+{
+    free(resultado->distancia);
+    free(resultado->alcancados);
+    free(resultado->excentricidade);
+    free(resultado->somaDistancias);
+    free(resultado);
+}
+
+typedef struct buscaMultipla
+{
+    GrafoCSR *csr;
+    int *fontes;
+    int numFontes;
+    ResultadoBuscaMultipla *resultado;
+} BuscaMultipla;
+
+/* A fonte f alcancou o vertice v no nivel dado */
+static void registraDistanciaMultipla(ResultadoBuscaMultipla *resultado, int f, int v, int nivel)
+{
+    if (resultado->distancia != NULL)
+        resultado->distancia[(size_t)f * resultado->ordem + v] = nivel;
+    resultado->alcancados[f]++;
+    resultado->excentricidade[f] = nivel; /* os niveis so crescem */
+    resultado->somaDistancias[f] += nivel;
+}
+
+/**
+ * Busca de cada lote, de inicio ate fim - 1. Por nivel, cada vertice u da
+ * fronteira passa a cada vizinho w as fontes que chegaram a u no nivel
+ * anterior e ainda nao viram w: visita[u] & ~vistos[w]
+*/
+static void tarefaBuscaMultipla(void *dados, int inicio, int fim)
+{
+    BuscaMultipla *busca = (BuscaMultipla *)dados;
+    GrafoCSR *csr = busca->csr;
+    ResultadoBuscaMultipla *resultado = busca->resultado;
+    MascaraFontes *vistos, *visita, *proximaVisita, *trocaMascaras;
+    MascaraFontes novos;
+    int *fronteira, *proxima, *trocaFronteira;
+    int tamanhoFronteira, tamanhoProxima;
+    int lote, primeiraFonte, tamanhoLote, nivel, i, j, u, w;
+    int tamanho = csr->ordem > 0 ? csr->ordem : 1;
+
+    vistos = (MascaraFontes *)calloc(tamanho, sizeof(MascaraFontes));
+    visita = (MascaraFontes *)calloc(tamanho, sizeof(MascaraFontes));
+    proximaVisita = (MascaraFontes *)calloc(tamanho, sizeof(MascaraFontes));
+    fronteira = (int *)malloc(sizeof(int) * tamanho);
+    proxima = (int *)malloc(sizeof(int) * tamanho);
+
+    for (lote = inicio; lote < fim; lote++)
+    {
+        primeiraFonte = lote * FONTES_POR_LOTE;
+        tamanhoLote = busca->numFontes - primeiraFonte;
+        if (tamanhoLote > FONTES_POR_LOTE)
+            tamanhoLote = FONTES_POR_LOTE;
+
+        tamanhoFronteira = 0;
+        for (i = 0; i < tamanhoLote; i++)
+        {
+            u = busca->fontes[primeiraFonte + i];
+            if (u < 0 || u >= csr->ordem) /* Testo se vertice e valido */
+                continue;
+            if (visita[u] == 0)
+                fronteira[tamanhoFronteira++] = u;
+            visita[u] |= (MascaraFontes)1 << i;
+            vistos[u] |= (MascaraFontes)1 << i;
+            registraDistanciaMultipla(resultado, primeiraFonte + i, u, 0);
+        }
+
+        for (nivel = 1; tamanhoFronteira > 0; nivel++)
+        {
+            tamanhoProxima = 0;
+            for (i = 0; i < tamanhoFronteira; i++)
+            {
+                u = fronteira[i];
+                for (j = csr->inicio[u]; j < csr->inicio[u + 1]; j++)
+                {
+                    w = csr->vizinhos[j];
+                    novos = visita[u] & ~vistos[w];
+                    if (novos == 0)
+                        continue;
+
+                    if (proximaVisita[w] == 0)
+                        proxima[tamanhoProxima++] = w;
+                    proximaVisita[w] |= novos;
+                    vistos[w] |= novos;
+                }
+            }
+
+            for (i = 0; i < tamanhoFronteira; i++)
+                visita[fronteira[i]] = 0;
+
+            /*Distancias dos vertices descobertos, fonte a fonte (bit a bit)*/
+            for (i = 0; i < tamanhoProxima; i++)
+            {
+                w = proxima[i];
+                for (novos = proximaVisita[w]; novos != 0; novos &= novos - 1)
+                    registraDistanciaMultipla(resultado, primeiraFonte + __builtin_ctzl(novos), w, nivel);
+            }
+
+            trocaMascaras = visita;
+            visita = proximaVisita;
+            proximaVisita = trocaMascaras;
+            trocaFronteira = fronteira;
+            fronteira = proxima;
+            proxima = trocaFronteira;
+            tamanhoFronteira = tamanhoProxima;
+        }
+
+        memset(vistos, 0, sizeof(MascaraFontes) * tamanho);
+    }
+
+    free(vistos);
+    free(visita);
+    free(proximaVisita);
+    free(fronteira);
+    free(proxima);
+}
+
+/**
+ * Buscas em largura a partir de cada uma das numFontes fontes, feitas em
+ * lotes de FONTES_POR_LOTE fontes que percorrem o grafo juntas. As distancias
+ * sao as mesmas de buscaLarguraCSR a partir de cada fonte (INT_MAX para
+ * vertices nao alcancados). Os lotes sao independentes e divididos entre
+ * numThreads threads
+*/
+void buscaLarguraMultiplaCSR(GrafoCSR *csr, int fontes[], int numFontes, int numThreads, ResultadoBuscaMultipla *resultado)
+{
+    BuscaMultipla busca;
+    size_t total, j;
+    int i;
+
+    if (resultado->distancia != NULL)
+    {
+        total = (size_t)numFontes * csr->ordem;
+        for (j = 0; j < total; j++)
+            resultado->distancia[j] = INT_MAX;
+    }
+    for (i = 0; i < numFontes; i++)
+    {
+        resultado->alcancados[i] = 0;
+        resultado->excentricidade[i] = 0;
+        resultado->somaDistancias[i] = 0;
+    }
+
+    busca.csr = csr;
+    busca.fontes = fontes;
+    busca.numFontes = numFontes;
+    busca.resultado = resultado;
+
+    executaEmParalelo(tarefaBuscaMultipla, &busca, (numFontes + FONTES_POR_LOTE - 1) / FONTES_POR_LOTE, numThreads);
+}
+
+/**
+ * Maior distancia finita da ultima busca em largura (a excentricidade
+ * do vertice inicial), e um dos vertices a essa distancia
+*/
+static int excentricidadeBusca(ResultadoBuscaLargura *resultado, int *maisDistante)
+{
+    int v, maior;
+
+    maior = -1;
+    *maisDistante = ELEMENTO_NAO_DEFINIDO;
+    for (v = 0; v < resultado->ordem; v++)
+    {
+        if (resultado->distancia[v] != INT_MAX && resultado->distancia[v] > maior)
+        {
+            maior = resultado->distancia[v];
+            *maisDistante = v;
+        }
+    }
+
+    return maior;
+}
+
+typedef struct componenteDiametro
+{
+    int raiz;    /* nome da componente */
+    int tamanho;
+    int inicial; /* vertice de maior grau, onde comecam as buscas */
+} ComponenteDiametro;
+
+static int comparaComponentesDiametro(const void *a, const void *b)
+{
+    const ComponenteDiametro *x = (const ComponenteDiametro *)a;
+    const ComponenteDiametro *y = (const ComponenteDiametro *)b;
+    return (y->tamanho > x->tamanho) - (y->tamanho < x->tamanho);
+}
+
+/**
+ * Estado do calculo do diametro: buscasRestantes < 0 significa sem limite
+*/
+typedef struct calculoDiametro
+{
+    GrafoCSR *csr;
+    ResultadoBuscaLargura *largura;
+    int *porDistancia; /* vertices da componente em ordem de distancia a u */
+    int *inicioNivel;
+    int buscasRestantes;
+} CalculoDiametro;
+
+/* Uma busca a partir de v, se ainda houver buscas; retorna a excentricidade de v */
+static int buscaDiametro(CalculoDiametro *calculo, int v, int *maisDistante)
+{
+    if (calculo->buscasRestantes > 0)
+        calculo->buscasRestantes--;
+    buscaLarguraHibridaCSR(calculo->csr, v, calculo->largura);
+    return excentricidadeBusca(calculo->largura, maisDistante);
+}
+
+/**
+ * Diametro da componente de inicial pelo algoritmo iFUB:
+ * 
+ * - varredura dupla: a busca a partir de inicial encontra a, e a busca
+ *   a partir de a encontra b; ecc(a) e um limite inferior, e o vertice
+ *   u no meio do caminho de a ate b costuma ser bem central;
+ * - os vertices sao agrupados pela distancia i ate u. Vertices a distancia
+ *   no maximo i - 1 de u estao a no maximo 2(i - 1) um do outro, entao,
+ *   depois das buscas a partir de todos os vertices do nivel i, o diametro
+ *   e o maior valor encontrado ou no maximo 2(i - 1).
+ * 
+ * Retorna o maior valor encontrado, que e o diametro se as buscas nao
+ * acabarem antes; limiteSuperior recebe o limite superior
+*/
+static int diametroComponente(CalculoDiametro *calculo, int inicial, int limiteInferior, int *limiteSuperior)
+{
+    GrafoCSR *csr = calculo->csr;
+    int *distancia = calculo->largura->distancia;
+    int a, b, u, e, i, j, v, passos, maisDistante;
+
+    *limiteSuperior = INT_MAX;
+    if (calculo->buscasRestantes == 0)
+        return limiteInferior;
+
+    /*Varredura dupla. Qualquer vertice v da o limite superior 2 ecc(v)*/
+    e = buscaDiametro(calculo, inicial, &a);
+    *limiteSuperior = 2 * e;
+    if (calculo->buscasRestantes == 0)
+        return limiteInferior;
+    e = buscaDiametro(calculo, a, &b);
+    if (e > limiteInferior)
+        limiteInferior = e;
+    if (2 * e < *limiteSuperior)
+        *limiteSuperior = 2 * e;
+
+    u = b;
+    for (passos = 0; passos < e / 2; passos++)
+        u = calculo->largura->pai[u];
+
+    if (calculo->buscasRestantes == 0)
+        return limiteInferior;
+    e = buscaDiametro(calculo, u, &maisDistante);
+    if (e > limiteInferior)
+        limiteInferior = e;
+    if (2 * e < *limiteSuperior)
+        *limiteSuperior = 2 * e;
+
+    /*Vertices da componente ordenados pela distancia a u (contagem)*/
+    for (i = 0; i <= e + 1; i++)
+        calculo->inicioNivel[i] = 0;
+    for (v = 0; v < csr->ordem; v++)
+        if (distancia[v] != INT_MAX)
+            calculo->inicioNivel[distancia[v] + 1]++;
+    for (i = 0; i < e + 1; i++)
+        calculo->inicioNivel[i + 1] += calculo->inicioNivel[i];
+    for (v = 0; v < csr->ordem; v++)
+        if (distancia[v] != INT_MAX)
+            calculo->porDistancia[calculo->inicioNivel[distancia[v]]++] = v;
+    for (i = e + 1; i > 0; i--)
+        calculo->inicioNivel[i] = calculo->inicioNivel[i - 1];
+    calculo->inicioNivel[0] = 0;
+
+    for (i = e; i > 0 && *limiteSuperior > limiteInferior; i--)
+    {
+        for (j = calculo->inicioNivel[i]; j < calculo->inicioNivel[i + 1]; j++)
+        {
+            if (calculo->buscasRestantes == 0)
+                return limiteInferior;
+
+            v = buscaDiametro(calculo, calculo->porDistancia[j], &maisDistante);
+            if (v > limiteInferior)
+                limiteInferior = v;
+        }
+
+        if ((limiteInferior > 2 * (i - 1) ? limiteInferior : 2 * (i - 1)) < *limiteSuperior)
+            *limiteSuperior = limiteInferior > 2 * (i - 1) ? limiteInferior : 2 * (i - 1);
+    }
+
+    if (*limiteSuperior < limiteInferior)
+        *limiteSuperior = limiteInferior;
+    return limiteInferior;
+}
+
+/**
+ * Diametro do grafo: a maior distancia entre dois vertices ligados por
+ * algum caminho (em grafos nao conexos, o maior diametro das componentes).
+ * 
+ * As componentes sao examinadas da maior para a menor, e param de ser
+ * examinadas quando nao podem mais ter um diametro maior (uma componente
+ * de k vertices tem diametro no maximo k - 1). Em cada componente, iFUB
+ * costuma precisar de poucas buscas em grafos reais.
+ * 
+ * Com maxBuscas > 0, para depois desse numero de buscas e retorna o maior
+ * valor encontrado ate entao. limiteSuperior (se nao for NULL) recebe um
+ * limite superior do diametro, igual ao retorno quando ele e exato
+*/
+int calculaDiametroCSR(GrafoCSR *csr, int maxBuscas, int *limiteSuperior)
+{
+    CalculoDiametro calculo;
+    ComponenteDiametro *componentes;
+    int *componente, *indice;
+    int numComponentesGrafo, i, v, raiz, grau;
+    int diametro, superior, superiorComponente;
+
+    if (limiteSuperior != NULL)
+        *limiteSuperior = 0;
+    if (csr->ordem == 0)
+        return 0;
+
+    componente = (int *)malloc(sizeof(int) * csr->ordem);
+    indice = (int *)malloc(sizeof(int) * csr->ordem);
+    componentes = (ComponenteDiametro *)malloc(sizeof(ComponenteDiametro) * csr->ordem);
+    definirComponentesParaleloCSR(csr, componente, 1);
+
+    /*Tamanho e vertice de maior grau de cada componente*/
+    numComponentesGrafo = 0;
+    for (v = 0; v < csr->ordem; v++)
+    {
+        raiz = componente[v];
+        grau = csr->inicio[v + 1] - csr->inicio[v];
+        if (raiz == v)
+        {
+            indice[v] = numComponentesGrafo++;
+            componentes[indice[v]].raiz = v;
+            componentes[indice[v]].tamanho = 0;
+            componentes[indice[v]].inicial = v;
+        }
+
+        i = indice[raiz];
+        componentes[i].tamanho++;
+        if (grau > csr->inicio[componentes[i].inicial + 1] - csr->inicio[componentes[i].inicial])
+            componentes[i].inicial = v;
+    }
+    qsort(componentes, numComponentesGrafo, sizeof(ComponenteDiametro), comparaComponentesDiametro);
+
+    calculo.csr = csr;
+    calculo.largura = criaResultadoBuscaLargura(csr->ordem);
+    calculo.porDistancia = indice; /* reaproveitado */
+    calculo.inicioNivel = (int *)malloc(sizeof(int) * (csr->ordem + 2));
+    calculo.buscasRestantes = maxBuscas > 0 ? maxBuscas : -1;
+
+    diametro = 0;
+    superior = 0;
+    for (i = 0; i < numComponentesGrafo && componentes[i].tamanho - 1 > diametro; i++)
+    {
+        if (calculo.buscasRestantes == 0)
+        {
+            /*Componentes nao examinadas: limitadas pelo tamanho*/
+            if (componentes[i].tamanho - 1 > superior)
+                superior = componentes[i].tamanho - 1;
+            break;
+        }
+
+        diametro = diametroComponente(&calculo, componentes[i].inicial, diametro, &superiorComponente);
+        if (superiorComponente > componentes[i].tamanho - 1)
+            superiorComponente = componentes[i].tamanho - 1;
+        if (superiorComponente > superior)
+            superior = superiorComponente;
+    }
+
+    if (superior < diametro)
+        superior = diametro;
+    if (limiteSuperior != NULL)
+        *limiteSuperior = superior;
+
+    liberaResultadoBuscaLargura(calculo.largura);
+    free(calculo.inicioNivel);
+    free(componentes);
+    free(indice);
+    free(componente);
+    return diametro;
+}
+
+/**
+ * Excentricidade de cada vertice (maior distancia ate um vertice da sua
+ * componente), pelos limites de Takes e Kosters: depois de uma busca a
+ * partir de v, para todo w alcancado,
+ * 
+ *   max(d(v, w), ecc(v) - d(v, w)) <= ecc(w) <= ecc(v) + d(v, w)
+ * 
+ * As buscas partem, alternadamente, do vertice pendente de maior limite
+ * superior e do de menor limite inferior, ate que os limites de todos os
+ * vertices se encontrem, o que costuma acontecer com bem menos buscas
+ * do que vertices.
+ * 
+ * excentricidade recebe os limites inferiores, e limiteSuperior (se nao
+ * for NULL) os superiores. Retorna o numero de vertices cuja excentricidade
+ * nao ficou exata por causa de maxBuscas (0: todas exatas)
+*/
+int calculaExcentricidadesCSR(GrafoCSR *csr, int excentricidade[], int limiteSuperior[], int maxBuscas)
+{
+    ResultadoBuscaLargura *largura;
+    int *inferior = excentricidade;
+    int *superior = limiteSuperior;
+    int pendentes, buscas, v, w, escolhido, e, d, grau, grauEscolhido;
+    bool escolheMaior, pendente;
+
+    if (superior == NULL)
+        superior = (int *)malloc(sizeof(int) * (csr->ordem > 0 ? csr->ordem : 1));
+
+    pendentes = 0;
+    for (v = 0; v < csr->ordem; v++)
+    {
+        inferior[v] = 0;
+        superior[v] = csr->inicio[v + 1] > csr->inicio[v] ? INT_MAX : 0; /* isolado: excentricidade 0 */
+        if (inferior[v] != superior[v])
+            pendentes++;
+    }
+
+    largura = criaResultadoBuscaLargura(csr->ordem);
+    escolheMaior = true;
+    for (buscas = 0; pendentes > 0 && (maxBuscas <= 0 || buscas < maxBuscas); buscas++)
+    {
+        /*Escolha do proximo vertice; empates decididos pelo maior grau*/
+        escolhido = ELEMENTO_NAO_DEFINIDO;
+        grauEscolhido = -1;
+        for (v = 0; v < csr->ordem; v++)
+        {
+            if (inferior[v] == superior[v])
+                continue;
+
+            grau = csr->inicio[v + 1] - csr->inicio[v];
+            if (escolhido == ELEMENTO_NAO_DEFINIDO ||
+                (escolheMaior && (superior[v] > superior[escolhido] ||
+                                  (superior[v] == superior[escolhido] && grau > grauEscolhido))) ||
+                (!escolheMaior && (inferior[v] < inferior[escolhido] ||
+                                   (inferior[v] == inferior[escolhido] && grau > grauEscolhido))))
+            {
+                escolhido = v;
+                grauEscolhido = grau;
+            }
+        }
+        escolheMaior = !escolheMaior;
+
+        buscaLarguraHibridaCSR(csr, escolhido, largura);
+        e = excentricidadeBusca(largura, &w);
+
+        for (w = 0; w < csr->ordem; w++)
+        {
+            d = largura->distancia[w];
+            if (d == INT_MAX)
+                continue;
+
+            pendente = inferior[w] != superior[w];
+            if (d > inferior[w])
+                inferior[w] = d;
+            if (e - d > inferior[w])
+                inferior[w] = e - d;
+            if (e + d < superior[w])
+                superior[w] = e + d;
+            if (pendente && inferior[w] == superior[w])
+                pendentes--;
+        }
+    }
+
+    liberaResultadoBuscaLargura(largura);
+    if (limiteSuperior == NULL)
+        free(superior);
+    return pendentes;
+}
+
+/**
+ * Pedaco de um arquivo texto de arestas, lido por uma unica thread.
+ * Comeca no inicio de uma linha e termina no inicio de outra
+*/
+typedef struct pedacoArquivo
+{
+    const char *inicio;
+    const char *fim;
+    int *arestas; /* pares de extremos, como em criaGrafoCSRArestas */
+    int numArestas;
+    int capacidade;
+    int maiorVertice;
+    int primeiraAresta; /* posicao das arestas do pedaco no vetor juntado */
+} PedacoArquivo;
+
+typedef struct leituraArestas
+{
+    PedacoArquivo *pedacos;
+    int base;     /* nome do primeiro vertice no arquivo: 0 (SNAP) ou 1 (Matrix Market) */
+    int *arestas; /* arestas de todos os pedacos, na ordem do arquivo */
+} LeituraArestas;
+
+/**
+ * Le um inteiro nao negativo a partir de p, pulando espacos e tabulacoes.
+ * Retorna a posicao logo apos o numero, ou NULL se nao houver numero
+ * na linha ou se ele nao couber em um int
+*/
+static const char *leInteiro(const char *p, const char *fim, int *valor)
+{
+    long numero = 0;
+
+    while (p < fim && (*p == ' ' || *p == '\t'))
+        p++;
+    if (p == fim || *p < '0' || *p > '9')
+        return NULL;
+
+    while (p < fim && *p >= '0' && *p <= '9')
+    {
+        numero = numero * 10 + (*p - '0');
+        if (numero > INT_MAX)
+            return NULL;
+        p++;
+    }
+
+    *valor = (int)numero;
+    return p;
+}
+
+/* Posicao logo apos o fim da linha em que p esta */
+static const char *proximaLinha(const char *p, const char *fim)
+{
+    while (p < fim && *p != '\n')
+        p++;
+    return p < fim ? p + 1 : fim;
+}
+
+/**
+ * Le as arestas de um pedaco: os dois primeiros inteiros de cada linha.
+ * Linhas de comentario (# ou %), vazias ou invalidas sao ignoradas,
+ * assim como colunas a mais (pesos, no Matrix Market)
+*/
+static void lePedacoArquivo(PedacoArquivo *pedaco, int base)
+{
+    const char *p = pedaco->inicio;
+    const char *fim = pedaco->fim;
+    const char *depois;
+    int v1, v2;
+
+    while (p < fim)
+    {
+        depois = leInteiro(p, fim, &v1);
+        if (depois != NULL)
+            depois = leInteiro(depois, fim, &v2);
+
+        if (depois != NULL && v1 >= base && v2 >= base)
+        {
+            if (pedaco->numArestas == pedaco->capacidade)
+            {
+                pedaco->capacidade *= 2;
+                pedaco->arestas = (int *)realloc(pedaco->arestas, sizeof(int) * 2 * pedaco->capacidade);
+            }
+            pedaco->arestas[2 * pedaco->numArestas] = v1 - base;
+            pedaco->arestas[2 * pedaco->numArestas + 1] = v2 - base;
+            pedaco->numArestas++;
+
+            if (v1 - base > pedaco->maiorVertice)
+                pedaco->maiorVertice = v1 - base;
+            if (v2 - base > pedaco->maiorVertice)
+                pedaco->maiorVertice = v2 - base;
+        }
+
+        p = proximaLinha(depois != NULL ? depois : p, fim);
+    }
+}
+
+static void tarefaLePedacos(void *dados, int inicio, int fim)
+{
+    LeituraArestas *leitura = (LeituraArestas *)dados;
+    int i;
+
+    for (i = inicio; i < fim; i++)
+        lePedacoArquivo(&leitura->pedacos[i], leitura->base);
+}
+
+/* Copia as arestas de cada pedaco para a sua posicao no vetor juntado */
+static void tarefaJuntaPedacos(void *dados, int inicio, int fim)
+{
+    LeituraArestas *leitura = (LeituraArestas *)dados;
+    PedacoArquivo *pedaco;
+    int i;
+
+    for (i = inicio; i < fim; i++)
+    {
+        pedaco = &leitura->pedacos[i];
+        memcpy(&leitura->arestas[2 * (size_t)pedaco->primeiraAresta], pedaco->arestas,
+               sizeof(int) * 2 * (size_t)pedaco->numArestas);
+        free(pedaco->arestas);
+    }
+}
+
+/**
+ * Carrega um grafo de um arquivo texto com uma aresta por linha, em um
+ * dos formatos:
+ * 
+ * - lista de arestas (SNAP): "v1 v2", vertices a partir de 0, comentarios
+ *   comecando com '#'. A ordem e o maior vertice encontrado mais 1;
+ * - Matrix Market: cabecalho "%%MatrixMarket", comentarios com '%', uma linha
+ *   "linhas colunas entradas" e depois "v1 v2 [valor]", a partir de 1.
+ * 
+ * O arquivo e mapeado na memoria e dividido em numThreads pedacos, separados
+ * em fins de linha, lidos em paralelo. Os pedacos sao juntados, tambem em
+ * paralelo, na ordem do arquivo, e o grafo e montado direto na forma CSR por
+ * criaGrafoCSRParalelo, com os vizinhos de cada vertice em ordem crescente
+ * para que o resultado nao dependa do numero de threads.
+ * Retorna NULL se o arquivo nao puder ser aberto
+*/
+GrafoCSR *carregaArestasTexto(const char *nomeArquivo, int numThreads)
+{
+    LeituraArestas leitura;
+    GrafoCSR *csr;
+    struct stat dadosArquivo;
+    const char *texto, *dados, *fim, *p;
+    int ordem, linhas, colunas, total, i;
+    int descritor;
+
+    descritor = open(nomeArquivo, O_RDONLY);
+    if (descritor < 0)
+        return NULL;
+    if (fstat(descritor, &dadosArquivo) != 0)
+    {
+        close(descritor);
+        return NULL;
+    }
+    if (dadosArquivo.st_size == 0)
+    {
+        close(descritor);
+        return criaGrafoCSRArestas(0, NULL, 0);
+    }
+
+    texto = (const char *)mmap(NULL, dadosArquivo.st_size, PROT_READ, MAP_PRIVATE, descritor, 0);
+    close(descritor);
+    if ((void *)texto == MAP_FAILED)
+        return NULL;
+    posix_madvise((void *)texto, dadosArquivo.st_size, POSIX_MADV_SEQUENTIAL);
+
+    fim = texto + dadosArquivo.st_size;
+    dados = texto;
+    ordem = 0;
+    leitura.base = 0;
+
+    /*Matrix Market: comentarios e linha de tamanho sao lidos antes da divisao*/
+    if ((size_t)dadosArquivo.st_size >= 14 && memcmp(texto, "%%MatrixMarket", 14) == 0)
+    {
+        leitura.base = 1;
+        while (dados < fim && (*dados == '%' || *dados == '\n' || *dados == '\r'))
+            dados = proximaLinha(dados, fim);
+
+        p = leInteiro(dados, fim, &linhas);
+        if (p != NULL)
+            p = leInteiro(p, fim, &colunas);
+        if (p != NULL)
+            ordem = linhas > colunas ? linhas : colunas;
+        dados = proximaLinha(dados, fim);
+    }
+
+    /*Divisao em pedacos de tamanhos parecidos, cada um comecando em uma linha*/
+    if (numThreads < 1)
+        numThreads = 1;
+    leitura.pedacos = (PedacoArquivo *)malloc(sizeof(PedacoArquivo) * numThreads);
+    for (i = 0; i < numThreads; i++)
+    {
+        p = dados + (fim - dados) / numThreads * i;
+        if (i > 0 && p > dados && p[-1] != '\n')
+            p = proximaLinha(p, fim);
+        if (i > 0 && p < leitura.pedacos[i - 1].inicio)
+            p = leitura.pedacos[i - 1].inicio;
+
+        leitura.pedacos[i].inicio = p;
+        if (i > 0)
+            leitura.pedacos[i - 1].fim = p;
+
+        leitura.pedacos[i].numArestas = 0;
+        leitura.pedacos[i].capacidade = ARESTAS_INICIAIS_PEDACO;
+        leitura.pedacos[i].arestas = (int *)malloc(sizeof(int) * 2 * ARESTAS_INICIAIS_PEDACO);
+        leitura.pedacos[i].maiorVertice = -1;
+    }
+    leitura.pedacos[numThreads - 1].fim = fim;
+
+    executaEmParalelo(tarefaLePedacos, &leitura, numThreads, numThreads);
+
+    /*Juncao dos pedacos, na ordem do arquivo: cada um sabe onde comeca*/
+    total = 0;
+    for (i = 0; i < numThreads; i++)
+    {
+        leitura.pedacos[i].primeiraAresta = total;
+        total += leitura.pedacos[i].numArestas;
+        if (leitura.base == 0 && leitura.pedacos[i].maiorVertice + 1 > ordem)
+            ordem = leitura.pedacos[i].maiorVertice + 1;
+    }
+
+    leitura.arestas = (int *)malloc(sizeof(int) * 2 * (size_t)(total > 0 ? total : 1));
+    executaEmParalelo(tarefaJuntaPedacos, &leitura, numThreads, numThreads);
+    free(leitura.pedacos);
+    munmap((void *)texto, dadosArquivo.st_size);
+
+    csr = criaGrafoCSRParalelo(ordem, leitura.arestas, total, CONSTRUCAO_ORDENADA, numThreads);
+    free(leitura.arestas);
+
+    return csr;
+}
+
+/**
+ * Embaralha os bits de x (funcao de mistura de 32 bits). Os numeros
+ * aleatorios de cada aresta dependem apenas da semente e do numero
+ * da aresta, e nao da thread que a gerou nem da ordem de geracao
+*/
+static unsigned int misturaBits(unsigned int x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x & 0xffffffffU;
+}
+
+/* Proximo numero da sequencia aleatoria guardada em estado */
+static unsigned int proximoAleatorio(unsigned int *estado)
+{
+    *estado = (*estado + 0x9e3779b9U) & 0xffffffffU;
+    return misturaBits(*estado);
+}
+
+/* Numero aleatorio real entre 0 (inclusive) e 1 (exclusive) */
+static double proximoAleatorioReal(unsigned int *estado)
+{
+    return (proximoAleatorio(estado) >> 8) / 16777216.0;
+}
+
+/**
+ * Vertice aleatorio entre 0 e ordem - 1, sorteado com os 32 bits de
+ * proximoAleatorio. Os sorteios a partir do maior multiplo de ordem que
+ * cabe em 32 bits sao descartados, para que todo vertice tenha a mesma chance
+*/
+static int proximoVerticeAleatorio(unsigned int *estado, int ordem)
+{
+    unsigned int limite = 0xffffffffU - 0xffffffffU % (unsigned int)ordem;
+    unsigned int sorteio;
+
+    do
+        sorteio = proximoAleatorio(estado);
+    while (sorteio >= limite);
+
+    return (int)(sorteio % (unsigned int)ordem);
+}
+
+/* Inicio da sequencia aleatoria da aresta de numero i */
+static unsigned int estadoAresta(unsigned int semente, int i)
+{
+    return misturaBits(semente ^ misturaBits((unsigned int)i));
+}
+
+typedef struct geracaoArestas
+{
+    int *arestas;
+    unsigned int semente;
+    int ordem;
+    int escala;  /* R-MAT: ordem = 2^escala */
+    int colunas; /* grade */
+    unsigned int multiplicador; /* R-MAT: renomeacao dos vertices */
+    unsigned int deslocamento;
+} GeracaoArestas;
+
+/**
+ * Cada aresta R-MAT escolhe, nivel a nivel, um dos quatro quadrantes
+ * da matriz de adjacencia, definindo um bit de cada extremo por nivel.
+ * Os nomes sao embaralhados no fim por uma bijecao (v * impar + d) mod ordem,
+ * para que os vertices de grau alto nao fiquem todos no inicio
+*/
+static void tarefaGeraRMAT(void *dados, int inicio, int fim)
+{
+    GeracaoArestas *geracao = (GeracaoArestas *)dados;
+    unsigned int mascara = (unsigned int)geracao->ordem - 1;
+    unsigned int estado, v1, v2;
+    double r;
+    int i, nivel;
+
+    for (i = inicio; i < fim; i++)
+    {
+        estado = estadoAresta(geracao->semente, i);
+        v1 = 0;
+        v2 = 0;
+        for (nivel = 0; nivel < geracao->escala; nivel++)
+        {
+            r = proximoAleatorioReal(&estado);
+            v1 <<= 1;
+            v2 <<= 1;
+            if (r < PROBABILIDADE_RMAT_A)
+                continue;
+            else if (r < PROBABILIDADE_RMAT_A + PROBABILIDADE_RMAT_B)
+                v2 |= 1;
+            else if (r < PROBABILIDADE_RMAT_A + PROBABILIDADE_RMAT_B + PROBABILIDADE_RMAT_C)
+                v1 |= 1;
+            else
+            {
+                v1 |= 1;
+                v2 |= 1;
+            }
+        }
+
+        geracao->arestas[2 * i] = (int)((v1 * geracao->multiplicador + geracao->deslocamento) & mascara);
+        geracao->arestas[2 * i + 1] = (int)((v2 * geracao->multiplicador + geracao->deslocamento) & mascara);
+    }
+}
+
+static void tarefaGeraErdosRenyi(void *dados, int inicio, int fim)
+{
+    GeracaoArestas *geracao = (GeracaoArestas *)dados;
+    unsigned int estado;
+    int i;
+
+    for (i = inicio; i < fim; i++)
+    {
+        estado = estadoAresta(geracao->semente, i);
+        geracao->arestas[2 * i] = proximoVerticeAleatorio(&estado, geracao->ordem);
+        geracao->arestas[2 * i + 1] = proximoVerticeAleatorio(&estado, geracao->ordem);
+    }
+}
+
+/**
+ * Arestas das linhas inicio ate fim - 1 da grade. Cada linha tem colunas - 1
+ * arestas horizontais seguidas de colunas arestas verticais (exceto a ultima),
+ * entao a linha i comeca na aresta i * (2 * colunas - 1)
+*/
+static void tarefaGeraGrade(void *dados, int inicio, int fim)
+{
+    GeracaoArestas *geracao = (GeracaoArestas *)dados;
+    int colunas = geracao->colunas;
+    int linhas = geracao->ordem / colunas;
+    int i, j, k, v;
+
+    for (i = inicio; i < fim; i++)
+    {
+        k = i * (2 * colunas - 1);
+        for (j = 0; j + 1 < colunas; j++, k++)
+        {
+            v = i * colunas + j;
+            geracao->arestas[2 * k] = v;
+            geracao->arestas[2 * k + 1] = v + 1;
+        }
+        if (i + 1 == linhas)
+            continue;
+        for (j = 0; j < colunas; j++, k++)
+        {
+            v = i * colunas + j;
+            geracao->arestas[2 * k] = v;
+            geracao->arestas[2 * k + 1] = v + colunas;
+        }
+    }
+}
+
+static void tarefaGeraCaminho(void *dados, int inicio, int fim)
+{
+    GeracaoArestas *geracao = (GeracaoArestas *)dados;
+    int i;
+
+    for (i = inicio; i < fim; i++)
+    {
+        geracao->arestas[2 * i] = i;
+        geracao->arestas[2 * i + 1] = i + 1;
+    }
+}
+
+/**
+ * Grafo R-MAT no estilo do Graph500: 2^escala vertices e fatorArestas
+ * arestas por vertice, com distribuicao de graus muito desigual, como em
+ * redes sociais. Pode ter lacos e arestas repetidas.
+ * Retorna NULL se o numero de arestas nao couber em um int
+*/
+int *geraArestasRMAT(int escala, int fatorArestas, unsigned int semente, int numThreads, int *numArestas)
+{
+    GeracaoArestas geracao;
+    unsigned int estado;
+
+    *numArestas = 0;
+    if (escala < 0 || escala > 30 || fatorArestas < 0 ||
+        (fatorArestas > 0 && (1 << escala) > INT_MAX / 2 / fatorArestas))
+        return NULL;
+
+    geracao.ordem = 1 << escala;
+    geracao.escala = escala;
+    geracao.semente = semente;
+    *numArestas = fatorArestas * geracao.ordem;
+    geracao.arestas = (int *)malloc(sizeof(int) * (2 * (size_t)*numArestas + 1));
+
+    estado = misturaBits(~semente);
+    geracao.multiplicador = proximoAleatorio(&estado) | 1u; /* impar: bijecao modulo 2^escala */
+    geracao.deslocamento = proximoAleatorio(&estado);
+
+    executaEmParalelo(tarefaGeraRMAT, &geracao, *numArestas, numThreads);
+    return geracao.arestas;
+}
+
+/**
+ * Grafo aleatorio uniforme G(n, m): cada uma das arestasSorteadas arestas
+ * tem os dois extremos sorteados entre os ordem vertices.
+ * Pode ter lacos e arestas repetidas.
+ * Retorna NULL se os parametros forem invalidos
+*/
+int *geraArestasErdosRenyi(int ordem, int arestasSorteadas, unsigned int semente, int numThreads, int *numArestas)
+{
+    GeracaoArestas geracao;
+
+    *numArestas = 0;
+    if (ordem < 1 || arestasSorteadas < 0 || arestasSorteadas > INT_MAX / 2)
+        return NULL;
+
+    geracao.ordem = ordem;
+    geracao.semente = semente;
+    *numArestas = arestasSorteadas;
+    geracao.arestas = (int *)malloc(sizeof(int) * (2 * (size_t)*numArestas + 1));
+
+    executaEmParalelo(tarefaGeraErdosRenyi, &geracao, *numArestas, numThreads);
+    return geracao.arestas;
+}
+
+/**
+ * Grade de linhas x colunas vertices, cada um ligado ao da direita e
+ * ao de baixo. O vertice da linha i e coluna j e i * colunas + j.
+ * Retorna NULL se os parametros forem invalidos ou se o vetor de
+ * arestas (quase 4 inteiros por vertice) nao couber em um int
+*/
+int *geraArestasGrade(int linhas, int colunas, int numThreads, int *numArestas)
+{
+    GeracaoArestas geracao;
+
+    /*numArestas < 2 * ordem: com ordem <= INT_MAX / 4, 2 * numArestas + 1 cabe em um int*/
+    *numArestas = 0;
+    if (linhas < 1 || colunas < 1 || linhas > INT_MAX / 4 / colunas)
+        return NULL;
+
+    geracao.ordem = linhas * colunas;
+    geracao.colunas = colunas;
+    *numArestas = linhas * (colunas - 1) + (linhas - 1) * colunas;
+    geracao.arestas = (int *)malloc(sizeof(int) * (2 * (size_t)*numArestas + 1));
+
+    executaEmParalelo(tarefaGeraGrade, &geracao, linhas, numThreads);
+    return geracao.arestas;
+}
+
+/**
+ * Caminho 0 - 1 - ... - (ordem - 1): o grafo conexo de maior diametro,
+ * o pior caso para buscas sincronizadas por niveis
+*/
+int *geraArestasCaminho(int ordem, int numThreads, int *numArestas)
+{
+    GeracaoArestas geracao;
+
+    *numArestas = 0;
+    if (ordem < 1 || ordem > INT_MAX / 2)
+        return NULL;
+
+    geracao.ordem = ordem;
+    *numArestas = ordem - 1;
+    geracao.arestas = (int *)malloc(sizeof(int) * (2 * (size_t)*numArestas + 1));
+
+    executaEmParalelo(tarefaGeraCaminho, &geracao, *numArestas, numThreads);
+    return geracao.arestas;
+}
+
+/**
+ * Grava as arestas em um arquivo texto no formato SNAP, uma aresta
+ * por linha, que pode ser lido por carregaArestasTexto.
+ * Retorna 1 em caso de sucesso e 0 se houver erro de escrita
+*/
+int gravaArestasTexto(int arestas[], int numArestas, const char *nomeArquivo)
+{
+    FILE *arquivo;
+    int i, ok;
+
+    arquivo = fopen(nomeArquivo, "w");
+    if (arquivo == NULL)
+        return 0;
+
+    ok = fprintf(arquivo, "# Arestas: %d\n", numArestas) > 0;
+    for (i = 0; ok && i < numArestas; i++)
+        ok = fprintf(arquivo, "%d %d\n", arestas[2 * i], arestas[2 * i + 1]) > 0;
+
+    ok = fclose(arquivo) == 0 && ok;
+    return ok;
+}
+
+/**
+ * Referencias do oraculo: vertices de maior grau, que costumam estar em
+ * muitos caminhos minimos, evitando vizinhos de referencias ja escolhidas
+ * (que dariam quase os mesmos limites); ou vertices sorteados, distintos
+*/
+static void escolheReferencias(GrafoCSR *csr, int referencias[], int numReferencias, int selecao, unsigned int semente)
+{
+    unsigned char *estado; /* 0: livre, 1: vizinho de referencia, 2: referencia */
+    unsigned int aleatorio;
+    int i, j, v, melhor, grau, grauMelhor;
+
+    estado = (unsigned char *)calloc(csr->ordem > 0 ? csr->ordem : 1, sizeof(unsigned char));
+    aleatorio = misturaBits(semente);
+
+    for (i = 0; i < numReferencias; i++)
+    {
+        if (selecao == REFERENCIAS_ALEATORIAS)
+        {
+            do
+                melhor = proximoVerticeAleatorio(&aleatorio, csr->ordem);
+            while (estado[melhor] == 2);
+        }
+        else
+        {
+            melhor = ELEMENTO_NAO_DEFINIDO;
+            grauMelhor = -1;
+            for (v = 0; v < csr->ordem; v++)
+            {
+                if (estado[v] == 2)
+                    continue;
+                grau = csr->inicio[v + 1] - csr->inicio[v];
+                if (melhor == ELEMENTO_NAO_DEFINIDO || estado[v] < estado[melhor] ||
+                    (estado[v] == estado[melhor] && grau > grauMelhor))
+                {
+                    melhor = v;
+                    grauMelhor = grau;
+                }
+            }
+
+            for (j = csr->inicio[melhor]; j < csr->inicio[melhor + 1]; j++)
+                if (estado[csr->vizinhos[j]] == 0)
+                    estado[csr->vizinhos[j]] = 1;
+        }
+
+        estado[melhor] = 2;
+        referencias[i] = melhor;
+    }
+
+    free(estado);
+}
+
+/**
+ * Cria o oraculo com numReferencias vertices de referencia (no maximo a
+ * ordem do grafo), escolhidos por grau (REFERENCIAS_POR_GRAU) ou sorteados
+ * com a semente dada (REFERENCIAS_ALEATORIAS). As buscas a partir das
+ * referencias sao feitas juntas por buscaLarguraMultiplaCSR, um lote de
+ * FONTES_POR_LOTE referencias por thread de cada vez: so as distancias
+ * inteiras de um lote ficam na memoria junto da tabela de 16 bits.
+ * Retorna NULL se a memoria nao puder ser reservada.
+ * O grafo nao pode ser liberado enquanto o oraculo for usado
+*/
+OraculoDistancias *criaOraculoDistancias(GrafoCSR *csr, int numReferencias, int selecao, unsigned int semente, int numThreads)
+{
+    OraculoDistancias *oraculo = (OraculoDistancias *)malloc(sizeof(OraculoDistancias));
+    ResultadoBuscaMultipla *buscas;
+    size_t tamanho = csr->ordem > 0 ? (size_t)csr->ordem : 1;
+    int i, v, d, primeira, numLote, maxLote;
+
+    if (numReferencias > csr->ordem)
+        numReferencias = csr->ordem;
+    if (numReferencias < 0)
+        numReferencias = 0;
+
+    oraculo->csr = csr;
+    oraculo->numReferencias = numReferencias;
+    oraculo->referencias = (int *)malloc(sizeof(int) * (numReferencias > 0 ? numReferencias : 1));
+    oraculo->distancias = (DistanciaReferencia *)malloc(sizeof(DistanciaReferencia) * tamanho *
+                                                        (numReferencias > 0 ? (size_t)numReferencias : 1));
+    escolheReferencias(csr, oraculo->referencias, numReferencias, selecao, semente);
+
+    /*Um resultado do tamanho de um lote, reaproveitado por todos os lotes*/
+    maxLote = FONTES_POR_LOTE * (numThreads > 1 ? numThreads : 1);
+    if (maxLote > numReferencias)
+        maxLote = numReferencias;
+    buscas = criaResultadoBuscaMultipla(csr->ordem, maxLote, true);
+    if (buscas == NULL || oraculo->distancias == NULL)
+    {
+        if (buscas != NULL)
+            liberaResultadoBuscaMultipla(buscas);
+        free(oraculo->referencias);
+        free(oraculo->distancias);
+        free(oraculo);
+        return NULL;
+    }
+
+    for (primeira = 0; primeira < numReferencias; primeira += numLote)
+    {
+        numLote = numReferencias - primeira < maxLote ? numReferencias - primeira : maxLote;
+        buscaLarguraMultiplaCSR(csr, &oraculo->referencias[primeira], numLote, numThreads, buscas);
+
+        /*Transposicao do lote para uma linha por vertice*/
+        for (i = 0; i < numLote; i++)
+            for (v = 0; v < csr->ordem; v++)
+            {
+                d = buscas->distancia[(size_t)i * csr->ordem + v];
+                if (d == INT_MAX)
+                    d = REFERENCIA_INALCANCAVEL;
+                else if (d >= REFERENCIA_DISTANTE)
+                    d = REFERENCIA_DISTANTE;
+                oraculo->distancias[(size_t)v * numReferencias + primeira + i] = (DistanciaReferencia)d;
+            }
+    }
+    liberaResultadoBuscaMultipla(buscas);
+
+    oraculo->bidirecional = criaBuscaBidirecional(csr);
+
+    return oraculo;
+}
+
+void liberaOraculoDistancias(OraculoDistancias *oraculo)
+{
+    free(oraculo->referencias);
+    free(oraculo->distancias);
+    liberaBuscaBidirecional(oraculo->bidirecional);
+    free(oraculo);
+}
+
+/**
+ * Limites da distancia entre u e v pelas referencias. Retorna o limite
+ * superior (INT_MAX se nenhuma referencia alcancar os dois) e escreve o
+ * inferior em limiteInferior, se nao for NULL. Se uma referencia alcancar
+ * apenas um dos dois, eles estao em componentes diferentes, e os dois
+ * limites sao INT_MAX
+*/
+int estimaDistanciaOraculo(OraculoDistancias *oraculo, int u, int v, int *limiteInferior)
+{
+    int k = oraculo->numReferencias;
+    DistanciaReferencia *linhaU, *linhaV;
+    int i, du, dv, inferior, superior;
+
+    inferior = 0;
+    superior = INT_MAX;
+    if (u < 0 || u >= oraculo->csr->ordem || v < 0 || v >= oraculo->csr->ordem) /* Testo se vertices sao validos */
+        inferior = superior = INT_MAX;
+    else if (u == v)
+        superior = 0;
+    else
+    {
+        linhaU = &oraculo->distancias[(size_t)u * k];
+        linhaV = &oraculo->distancias[(size_t)v * k];
+        for (i = 0; i < k; i++)
+        {
+            du = linhaU[i];
+            dv = linhaV[i];
+            if (du == REFERENCIA_DISTANTE || dv == REFERENCIA_DISTANTE)
+                continue;
+            if ((du == REFERENCIA_INALCANCAVEL) != (dv == REFERENCIA_INALCANCAVEL))
+            {
+                inferior = superior = INT_MAX;
+                break;
+            }
+            if (du == REFERENCIA_INALCANCAVEL)
+                continue;
+
+            if (du + dv < superior)
+                superior = du + dv;
+            if (du - dv > inferior)
+                inferior = du - dv;
+            if (dv - du > inferior)
+                inferior = dv - du;
+        }
+        if (inferior == 0)
+            inferior = 1; /* u != v */
+    }
+
+    if (limiteInferior != NULL)
+        *limiteInferior = inferior;
+    return superior;
+}
+
+/**
+ * Distancia exata entre u e v (INT_MAX se nao houver caminho). Se os limites
+ * das referencias coincidirem, a resposta sai direto deles; senao e feita
+ * uma busca bidirecional apenas por caminhos menores que o limite superior
+*/
+int distanciaExataOraculo(OraculoDistancias *oraculo, int u, int v)
+{
+    int inferior, superior, distancia;
+
+    superior = estimaDistanciaOraculo(oraculo, u, v, &inferior);
+    if (inferior == superior)
+        return superior;
+    if (superior == INT_MAX)
+        return buscaLarguraBidirecionalCSR(oraculo->bidirecional, u, v, INT_MAX, NULL);
+
+    distancia = buscaLarguraBidirecionalCSR(oraculo->bidirecional, u, v, superior - 1, NULL);
+    return distancia == INT_MAX ? superior : distancia;
+}
+
+BuscaBidirecional *criaBuscaBidirecional(GrafoCSR *csr)
+{
+    BuscaBidirecional *busca = (BuscaBidirecional *)malloc(sizeof(BuscaBidirecional));
+    int tamanho = csr->ordem > 0 ? csr->ordem : 1;
+    int lado;
+
+    busca->csr = csr;
+    busca->consulta = 0;
+    for (lado = 0; lado < 2; lado++)
+    {
+        busca->marca[lado] = (int *)calloc(tamanho, sizeof(int));
+        busca->distancia[lado] = (int *)malloc(sizeof(int) * tamanho);
+        busca->pai[lado] = (int *)malloc(sizeof(int) * tamanho);
+        busca->fila[lado] = (int *)malloc(sizeof(int) * tamanho);
+    }
+
+    return busca;
+}
+
+void liberaBuscaBidirecional(BuscaBidirecional *busca)
+{
+    int lado;
+
+    for (lado = 0; lado < 2; lado++)
+    {
+        free(busca->marca[lado]);
+        free(busca->distancia[lado]);
+        free(busca->pai[lado]);
+        free(busca->fila[lado]);
+    }
+    free(busca);
+}
+
+/**
+ * Expande um nivel inteiro de um dos lados da busca. Retorna o menor
+ * comprimento de caminho encontrado ao tocar vertices ja vistos pelo
+ * outro lado (INT_MAX se nenhum), e as duas pontas da aresta desse caminho
+*/
+static int expandeNivelBidirecional(BuscaBidirecional *busca, int lado, int *inicio, int *fim,
+                                    int *encontroLado, int *encontroOutro)
+{
+    GrafoCSR *csr = busca->csr;
+    int *marca = busca->marca[lado], *marcaOutro = busca->marca[1 - lado];
+    int *distancia = busca->distancia[lado], *distanciaOutro = busca->distancia[1 - lado];
+    int melhor = INT_MAX;
+    int fimNivel = *fim;
+    int j, x, w;
+
+    for (; *inicio < fimNivel; (*inicio)++)
+    {
+        x = busca->fila[lado][*inicio];
+        CONTA_ARESTAS(csr->inicio[x + 1] - csr->inicio[x]);
+        for (j = csr->inicio[x]; j < csr->inicio[x + 1]; j++)
+        {
+            w = csr->vizinhos[j];
+            if (marcaOutro[w] == busca->consulta && distancia[x] + 1 + distanciaOutro[w] < melhor)
+            {
+                melhor = distancia[x] + 1 + distanciaOutro[w];
+                *encontroLado = x;
+                *encontroOutro = w;
+            }
+            if (marca[w] != busca->consulta)
+            {
+                marca[w] = busca->consulta;
+                distancia[w] = distancia[x] + 1;
+                busca->pai[lado][w] = x;
+                busca->fila[lado][(*fim)++] = w;
+                CONTA_ENFILEIRAMENTOS(1);
+            }
+        }
+    }
+
+    return melhor;
+}
+
+/**
+ * Distancia entre u e v por busca em largura bidirecional, considerando
+ * apenas caminhos de no maximo distanciaMaxima arestas (INT_MAX: qualquer
+ * um). Retorna INT_MAX se nao houver tal caminho; v e alcancavel a partir
+ * de u se o retorno for diferente de INT_MAX.
+ * 
+ * A cada passo, o lado de menor fronteira expande um nivel inteiro. No
+ * primeiro nivel em que os lados se tocam, o menor caminho encontrado
+ * nesse nivel e minimo; a busca entao para, sem percorrer o resto da
+ * componente. Se caminho nao for NULL (espaco para ordem vertices), recebe
+ * os vertices de um caminho minimo, de u ate v
+*/
+int buscaLarguraBidirecionalCSR(BuscaBidirecional *busca, int u, int v, int distanciaMaxima, int caminho[])
+{
+    int inicio[2], fim[2], nivel[2], meio[2];
+    int lado, melhor, encontrado, x, w, i;
+
+    ZERA_CONTADORES();
+
+    if (u < 0 || u >= busca->csr->ordem || v < 0 || v >= busca->csr->ordem) /* Testo se vertices sao validos */
+        return INT_MAX;
+    if (u == v)
+    {
+        if (caminho != NULL)
+            caminho[0] = u;
+        return 0;
+    }
+
+    if (busca->consulta == INT_MAX)
+    {
+        memset(busca->marca[0], 0, sizeof(int) * busca->csr->ordem);
+        memset(busca->marca[1], 0, sizeof(int) * busca->csr->ordem);
+        busca->consulta = 0;
+    }
+    busca->consulta++;
+
+    for (lado = 0; lado < 2; lado++)
+    {
+        x = lado == 0 ? u : v;
+        busca->marca[lado][x] = busca->consulta;
+        busca->distancia[lado][x] = 0;
+        busca->pai[lado][x] = ELEMENTO_NAO_DEFINIDO;
+        busca->fila[lado][0] = x;
+        inicio[lado] = 0;
+        fim[lado] = 1;
+        nivel[lado] = 0;
+    }
+
+    melhor = INT_MAX;
+    meio[0] = meio[1] = ELEMENTO_NAO_DEFINIDO;
+    x = w = ELEMENTO_NAO_DEFINIDO;
+    while (inicio[0] < fim[0] && inicio[1] < fim[1] &&
+           nivel[0] + nivel[1] + 1 < melhor && nivel[0] + nivel[1] + 1 <= distanciaMaxima)
+    {
+        lado = fim[0] - inicio[0] <= fim[1] - inicio[1] ? 0 : 1;
+        encontrado = expandeNivelBidirecional(busca, lado, &inicio[lado], &fim[lado], &x, &w);
+        nivel[lado]++;
+
+        if (encontrado < melhor)
+        {
+            melhor = encontrado;
+            meio[lado] = x;
+            meio[1 - lado] = w;
+        }
+    }
+
+    if (melhor == INT_MAX || melhor > distanciaMaxima)
+        return INT_MAX;
+
+    /*Caminho: de u ate meio[0] pelos pais do lado 0, e de meio[1] ate v pelos do lado 1*/
+    if (caminho != NULL)
+    {
+        for (i = busca->distancia[0][meio[0]], x = meio[0]; i >= 0; i--, x = busca->pai[0][x])
+            caminho[i] = x;
+        for (i = busca->distancia[0][meio[0]] + 1, x = meio[1]; x != ELEMENTO_NAO_DEFINIDO; i++, x = busca->pai[1][x])
+            caminho[i] = x;
+    }
+
+    return melhor;
+}
+
+/**
+ * Mesma busca em profundidade de buscaProfundida, sobre o grafo CSR
+*/
+void buscaProfundidaCSR(GrafoCSR *csr, ResultadoBuscaProfundidade *resultado)
+{
+    Pilha *pilha;
+    int tempo;
+    int j;
+
+    iniciaResultadoBuscaProfundidade(resultado);
+
+    pilha = inicializaPilha(csr->ordem);
+
+    tempo = 0;
+    for (j = 0; j < csr->ordem; j++)
+    {
+        if (!TESTA_BIT(resultado->visitados, j))
+            buscaProfundidaVisitaCSR(csr, j, &tempo, j, pilha, resultado);
+    }
+
+    liberaPilha(pilha);
+}
+
+/**
+ * Visita iterativa sobre o grafo CSR. Cada item da pilha 
+ * guarda a posicao do proximo vizinho em csr->vizinhos
+*/
+void buscaProfundidaVisitaCSR(GrafoCSR *csr, int verticeAtual, int *tempo, int componente, Pilha *pilha,
+                              ResultadoBuscaProfundidade *resultado)
+{
+    ItemPilha *item;
+    int j, fim, w;
+
+    descobreVertice(resultado, verticeAtual, tempo, componente);
+    empilha(pilha, verticeAtual)->proximo.posicao = csr->inicio[verticeAtual];
+
+    while (!pilhaEstaVazia(pilha))
+    {
+        item = topoPilha(pilha);
+
+        j = item->proximo.posicao;
+        fim = csr->inicio[item->vertice + 1];
+        while (j < fim && TESTA_BIT(resultado->visitados, csr->vizinhos[j]))
+            j++;
+        CONTA_ARESTAS(j - item->proximo.posicao + (j < fim));
+
+        if (j == fim)
+        {
+            finalizaVertice(resultado, item->vertice, tempo);
+            desempilha(pilha);
+            continue;
+        }
+
+        item->proximo.posicao = j + 1;
+
+        w = csr->vizinhos[j];
+        resultado->pai[w] = item->vertice;
+        descobreVertice(resultado, w, tempo, componente);
+        empilha(pilha, w)->proximo.posicao = csr->inicio[w];
+    }
+}
+
+/**
+ * Reserva os vetores da analise de biconexidade, que pode ser
+ * reaproveitada por varias analises de grafos da mesma ordem
+*/
+ResultadoBiconexas *criaResultadoBiconexas(int ordem)
+{
+    ResultadoBiconexas *resultado = (ResultadoBiconexas *)malloc(sizeof(ResultadoBiconexas));
+    int tamanho = ordem > 0 ? ordem : 1;
+
+    resultado->ordem = ordem;
+    resultado->profundidade = criaResultadoBuscaProfundidade(ordem);
+    resultado->menorAlcancavel = (int *)malloc(sizeof(int) * tamanho);
+    resultado->componente = (int *)malloc(sizeof(int) * tamanho);
+    resultado->articulacao = (PalavraBits *)malloc(sizeof(PalavraBits) * (PALAVRAS_MAPA_BITS(ordem) + 1));
+    resultado->ponte = (PalavraBits *)malloc(sizeof(PalavraBits) * (PALAVRAS_MAPA_BITS(ordem) + 1));
+
+    return resultado;
+}
+
+void liberaResultadoBiconexas(ResultadoBiconexas *resultado)
+{
+    liberaResultadoBuscaProfundidade(resultado->profundidade);
+    free(resultado->menorAlcancavel);
+    free(resultado->componente);
+    free(resultado->articulacao);
+    free(resultado->ponte);
+    free(resultado);
+}
+
+/**
+ * Fim da visita de v, filho de p na arvore: o menor tempo alcancavel pela
+ * subarvore de v sobe para p. Se ela nao alcanca nada acima de p, p separa
+ * a subarvore do resto, e os vertices empilhados desde v (inclusive)
+ * formam, com suas arestas da arvore, uma nova componente biconexa
+*/
+static void finalizaFilhoBiconexas(ResultadoBiconexas *resultado, int p, int v, int pilhaVertices[], int *topo)
+{
+    int *descoberta = resultado->profundidade->tempoDescoberta;
+    int x;
+
+    if (resultado->menorAlcancavel[v] < resultado->menorAlcancavel[p])
+        resultado->menorAlcancavel[p] = resultado->menorAlcancavel[v];
+
+    if (resultado->menorAlcancavel[v] < descoberta[p])
+        return;
+
+    /*Raizes sao tratadas pelo numero de filhos, ao fim da visita*/
+    if (resultado->profundidade->pai[p] != ELEMENTO_NAO_DEFINIDO && !TESTA_BIT(resultado->articulacao, p))
+    {
+        MARCA_BIT(resultado->articulacao, p);
+        resultado->numArticulacoes++;
+    }
+    if (resultado->menorAlcancavel[v] > descoberta[p])
+    {
+        MARCA_BIT(resultado->ponte, v);
+        resultado->numPontes++;
+    }
+
+    do
+    {
+        x = pilhaVertices[--(*topo)];
+        resultado->componente[x] = resultado->numComponentes;
+    } while (x != v);
+    resultado->numComponentes++;
+}
+
+/**
+ * Algoritmo de Tarjan sobre a busca em profundidade iterativa de
+ * buscaProfundidaVisitaCSR, que ja guarda pai e tempos de descoberta.
+ * Acrescenta apenas o menor tempo alcancavel de cada subarvore (low) e
+ * uma pilha de vertices, ambos com tamanho limitado a ordem, entao grafos
+ * com caminhos muito longos nao estouram a pilha de chamadas.
+ * 
+ * A aresta para o pai e ignorada uma unica vez, de modo que arestas
+ * paralelas formam um ciclo e nao sao pontes. Lacos sao ignorados
+*/
+void componentesBiconexasCSR(GrafoCSR *csr, ResultadoBiconexas *resultado)
+{
+    ResultadoBuscaProfundidade *profundidade = resultado->profundidade;
+    PalavraBits *paiIgnorado;
+    Pilha *pilha;
+    ItemPilha *item;
+    int *pilhaVertices;
+    int topo, tempo, raiz, filhosRaiz, v, w, j;
+
+    iniciaResultadoBuscaProfundidade(profundidade);
+    memset(resultado->articulacao, 0, sizeof(PalavraBits) * PALAVRAS_MAPA_BITS(resultado->ordem));
+    memset(resultado->ponte, 0, sizeof(PalavraBits) * PALAVRAS_MAPA_BITS(resultado->ordem));
+    resultado->numArticulacoes = 0;
+    resultado->numPontes = 0;
+    resultado->numComponentes = 0;
+
+    paiIgnorado = (PalavraBits *)calloc(PALAVRAS_MAPA_BITS(csr->ordem) + 1, sizeof(PalavraBits));
+    pilhaVertices = (int *)malloc(sizeof(int) * (csr->ordem > 0 ? csr->ordem : 1));
+    pilha = inicializaPilha(csr->ordem);
+
+    tempo = 0;
+    for (raiz = 0; raiz < csr->ordem; raiz++)
+    {
+        if (TESTA_BIT(profundidade->visitados, raiz))
+            continue;
+
+        descobreVertice(profundidade, raiz, &tempo, raiz);
+        resultado->menorAlcancavel[raiz] = profundidade->tempoDescoberta[raiz];
+        resultado->componente[raiz] = ELEMENTO_NAO_DEFINIDO;
+        empilha(pilha, raiz)->proximo.posicao = csr->inicio[raiz];
+        topo = 0;
+        filhosRaiz = 0;
+
+        while (!pilhaEstaVazia(pilha))
+        {
+            item = topoPilha(pilha);
+            v = item->vertice;
+            j = item->proximo.posicao;
+
+            if (j == csr->inicio[v + 1])
+            {
+                finalizaVertice(profundidade, v, &tempo);
+                desempilha(pilha);
+                if (profundidade->pai[v] != ELEMENTO_NAO_DEFINIDO)
+                    finalizaFilhoBiconexas(resultado, profundidade->pai[v], v, pilhaVertices, &topo);
+                continue;
+            }
+
+            item->proximo.posicao = j + 1;
+            w = csr->vizinhos[j];
+            CONTA_ARESTAS(1);
+
+            if (!TESTA_BIT(profundidade->visitados, w))
+            {
+                /*Aresta da arvore: w entra na pilha da busca e na de vertices*/
+                profundidade->pai[w] = v;
+                descobreVertice(profundidade, w, &tempo, raiz);
+                resultado->menorAlcancavel[w] = profundidade->tempoDescoberta[w];
+                pilhaVertices[topo++] = w;
+                empilha(pilha, w)->proximo.posicao = csr->inicio[w];
+                if (v == raiz)
+                    filhosRaiz++;
+            }
+            else if (w == profundidade->pai[v] && !TESTA_BIT(paiIgnorado, v))
+                MARCA_BIT(paiIgnorado, v);
+            else if (profundidade->tempoDescoberta[w] < resultado->menorAlcancavel[v])
+                resultado->menorAlcancavel[v] = profundidade->tempoDescoberta[w]; /*aresta de retorno*/
+        }
+
+        /*A raiz e articulacao se tiver mais de um filho na arvore*/
+        if (filhosRaiz > 1)
+        {
+            MARCA_BIT(resultado->articulacao, raiz);
+            resultado->numArticulacoes++;
+        }
+    }
+
+    liberaPilha(pilha);
+    free(pilhaVertices);
+    free(paiIgnorado);
+}
+
+/**
+ * Componente biconexa da aresta (u, v), que deve existir no grafo:
+ * a da aresta da arvore que chega ao extremo descoberto por ultimo
+*/
+int componenteBiconexaAresta(ResultadoBiconexas *resultado, int u, int v)
+{
+    int *descoberta = resultado->profundidade->tempoDescoberta;
+
+    return resultado->componente[descoberta[u] > descoberta[v] ? u : v];
+}
+
+bool ePonte(ResultadoBiconexas *resultado, int u, int v)
+{
+    int *pai = resultado->profundidade->pai;
+
+    if (pai[v] == u && TESTA_BIT(resultado->ponte, v))
+        return true;
+    return pai[u] == v && TESTA_BIT(resultado->ponte, u);
+}
+
+void imprimeBiconexas(ResultadoBiconexas *resultado)
+{
+    int v;
+
+    printf("Pontos de articulacao (%d):", resultado->numArticulacoes);
+    for (v = 0; v < resultado->ordem; v++)
+        if (TESTA_BIT(resultado->articulacao, v))
+            printf(" V%d", v);
+
+    printf("\nPontes (%d):", resultado->numPontes);
+    for (v = 0; v < resultado->ordem; v++)
+        if (TESTA_BIT(resultado->ponte, v))
+            printf(" V%d-V%d", resultado->profundidade->pai[v], v);
+
+    printf("\nComponentes biconexas (%d), pela aresta da arvore que chega a cada vertice:\n", resultado->numComponentes);
+    for (v = 0; v < resultado->ordem; v++)
+        if (resultado->componente[v] != ELEMENTO_NAO_DEFINIDO)
+            printf("V%d-V%d: %d\n", resultado->profundidade->pai[v], v, resultado->componente[v]);
+}
+
+/**
+ * Nao cria o grafo. Funcao a ser executada por todos os testes:
+ * Realiza a busca em profundidade e em largura, verifica a conexidade
+ * usando ambos os metodos e entao imprime o resultado
+ * 
+*/
+void testeGrafo(Vertice *G, int ordem, int verticeInicialBuscaLarg)
+{
+    ResultadoBuscaLargura *largura = criaResultadoBuscaLargura(ordem);
+    ResultadoBuscaProfundidade *profundidade = criaResultadoBuscaProfundidade(ordem);
+
+    buscaLargura(G, ordem, verticeInicialBuscaLarg, largura);
+    buscaProfundida(G, ordem, profundidade);
+    definirComponentesConjuntos(G, ordem);
+
+    imprimeGrafo(G, ordem);
+    imprimeBuscaLargura(largura);
+    imprimeBuscaProfundidade(profundidade);
+
+    printf("\n");
+    liberaResultadoBuscaLargura(largura);
+    liberaResultadoBuscaProfundidade(profundidade);
+}
+
+void testeGrafoNaoConexo()
+{
+    Vertice *G;
+    int ordemG = 5;
+
+    criaGrafo(&G, ordemG);
+    acrescentaAresta(G, ordemG, 0, 1);
+    acrescentaAresta(G, ordemG, 1, 2);
+    acrescentaAresta(G, ordemG, 2, 3);
+
+    testeGrafo(G, ordemG, 0);
+    liberaGrafo(G);
+}
+
+void testeGrafoConexo()
+{
+    Vertice *G;
+    int ordemG = 3;
+
+    criaGrafo(&G, ordemG);
+    acrescentaAresta(G, ordemG, 0, 1);
+    acrescentaAresta(G, ordemG, 1, 2);
+
+    testeGrafo(G, ordemG, 0);
+    liberaGrafo(G);
+}
+
+/**
+ * Grafo simples e completo: todos os vertices 
+ * adjacentes a todos os os outros vertices, sem laços 
+ * 
+ * Grafo conexo
+*/
+void testeGrafoCompleto(int ordemG)
+{
+    Vertice *G;
+    int i, j;
+
+    criaGrafo(&G, ordemG);
+
+    for (i = 0; i < ordemG; i++)
+        for (j = i + 1; j < ordemG; j++) /*+1: evitando lacos*/
+            acrescentaAresta(G, ordemG, i, j);
+
+    testeGrafo(G, ordemG, 0);
+    liberaGrafo(G);
+}
+
+/**
+ * Grafo simples e completo, com excecao de um vertice, que esta isolado
+ * Grafo nao conexo
+*/
+void testeGrafoCompletoExcetoPorUmVertice(int ordemG, int verticeIsolado)
+{
+    Vertice *G;
+    int i, j;
+
+    /*Validacao do indice do vertice isolado*/
+    if (verticeIsolado >= ordemG)
+    {
+        printf("Vertice isolado nao presente entre os vertices do grafo");
+        return;
+    }
+
+    criaGrafo(&G, ordemG);
+
+    for (i = 0; i < ordemG; i++)
+    {
+        if (i == verticeIsolado) continue; /*pulando vertice isolado*/
+        for (j = i + 1; j < ordemG; j++) /*+1: evitando lacos*/
+        {
+            if (j == verticeIsolado) continue; /*pulando vertice isolado*/
+            acrescentaAresta(G, ordemG, i, j);
+        }
+    }
+
+    testeGrafo(G, ordemG, 0);
+    liberaGrafo(G);
+}
+
+/**
+ * Mesmo grafo de testeGrafoNaoConexo, criado diretamente na forma
+ * compacta a partir da lista de arestas.
+ * Grafo nao conexo
+*/
+void testeGrafoCSR()
+{
+    GrafoCSR *csr;
+    ResultadoBuscaLargura *largura;
+    ResultadoBuscaProfundidade *profundidade;
+    int ordemG = 5;
+    int arestas[] = {0, 1, 1, 2, 2, 3};
+    int componente[5];
+
+    csr = criaGrafoCSRArestas(ordemG, arestas, 3);
+    largura = criaResultadoBuscaLargura(ordemG);
+    profundidade = criaResultadoBuscaProfundidade(ordemG);
+
+    /*Componentes sem busca; buscaProfundidaCSR deve marcar as mesmas*/
+    definirComponentesParaleloCSR(csr, componente, 2);
+    imprimeGrafoCSR(csr, componente);
+
+    buscaLarguraCSR(csr, 0, largura);
+    buscaProfundidaCSR(csr, profundidade);
+
+    imprimeGrafoCSR(csr, profundidade->componente);
+    imprimeBuscaLargura(largura);
+    imprimeBuscaProfundidade(profundidade);
+
+    printf("\n");
+    liberaResultadoBuscaLargura(largura);
+    liberaResultadoBuscaProfundidade(profundidade);
+    liberaGrafoCSR(csr);
+}
+
+/**
+ * Busca em largura hibrida sobre o grafo completo, em que quase
+ * todas as arestas levam a vertices ja visitados.
+ * Todos os vertices a distancia 1 do vertice inicial
+*/
+void testeBuscaLarguraHibrida(int ordemG)
+{
+    Vertice *G;
+    GrafoCSR *csr;
+    ResultadoBuscaLargura *largura;
+    int i, j;
+
+    criaGrafo(&G, ordemG);
+
+    for (i = 0; i < ordemG; i++)
+        for (j = i + 1; j < ordemG; j++)
+            acrescentaAresta(G, ordemG, i, j);
 
-        if (indicePai == ELEMENTO_NAO_DEFINIDO)
-            printf("V%d (não tem) (cor:%s) (tempo de descoberta: %d), (tempo de Finalização: %d)\n", i, cores[indiceCor], tDescoberta, tFinal);
+    csr = criaGrafoCSR(G, ordemG);
+    largura = criaResultadoBuscaLargura(ordemG);
+    buscaLarguraHibridaCSR(csr, 0, largura);
+    imprimeBuscaLargura(largura);
 
-        else
-            printf("V%d (pai: V%d) (cor:%s) (tempo de descoberta: %d), (tempo de Finalização: %d)\n", i, indicePai, cores[indiceCor], tDescoberta, tFinal);
-    }
-    printf("=========================:\n\n");
+    liberaResultadoBuscaLargura(largura);
+    liberaGrafoCSR(csr);
+    liberaGrafo(G);
 }
 
 /**
- * Inicializacao dos valores da fila, 
- * retorno do ponteiro para a fila inicializada
+ * Busca em largura paralela sobre um grafo em grade de lado x lado,
+ * com 4 threads. A distancia de cada vertice ao vertice 0 e a soma
+ * de sua linha e coluna
 */
-Fila *inicializaFila(int tamanho)
+void testeBuscaLarguraParalela(int lado)
 {
-    Fila *fila = (Fila *)malloc(sizeof(Fila));
+    Vertice *G;
+    GrafoCSR *csr;
+    ResultadoBuscaLargura *largura;
+    int ordemG = lado * lado;
+    int i, j;
 
-    fila->indiceRetirada = 0; /*indice a ser usado quando retirando primeiro elemento*/
-    fila->indiceInsercao = 0; /*indice a ser usado quando inserindo primeiro elemento*/
-    fila->tamanhoMax = tamanho;
-    fila->valores = (int *)calloc(tamanho, sizeof(int)); /*todos os elementos da fila igual a zero*/
+    criaGrafo(&G, ordemG);
 
-    return fila;
+    for (i = 0; i < lado; i++)
+        for (j = 0; j < lado; j++)
+        {
+            if (j + 1 < lado)
+                acrescentaAresta(G, ordemG, i * lado + j, i * lado + j + 1);
+            if (i + 1 < lado)
+                acrescentaAresta(G, ordemG, i * lado + j, (i + 1) * lado + j);
+        }
+
+    csr = criaGrafoCSR(G, ordemG);
+    largura = criaResultadoBuscaLargura(ordemG);
+    buscaLarguraParalelaCSR(csr, 0, 4, largura);
+    imprimeBuscaLargura(largura);
+
+    liberaResultadoBuscaLargura(largura);
+    liberaGrafoCSR(csr);
+    liberaGrafo(G);
 }
 
 /**
- * Adicao de elemento na fila. Considerando a estrutura de dados,
- * FIFO, vai ser o último a sair considerando todos os elementos 
- * que foram enfileirados anteriormente
+ * Grava o grafo de testeGrafoConexo em arquivo e carrega de volta,
+ * fazendo as buscas direto sobre o arquivo mapeado.
+ * Grafo conexo
 */
-void enfileira(Fila *fila, int elemento)
+void testeArquivoGrafo()
 {
-    /*validando se fila atingiu seu limite*/
-    if (fila->indiceInsercao >= fila->tamanhoMax)
+    Vertice *G;
+    GrafoCSR *csr;
+    ResultadoBuscaLargura *largura;
+    ResultadoBuscaProfundidade *profundidade;
+    const char *nomeArquivo = "grafo-teste.bin";
+    int ordemG = 3;
+
+    criaGrafo(&G, ordemG);
+    acrescentaAresta(G, ordemG, 0, 1);
+    acrescentaAresta(G, ordemG, 1, 2);
+
+    csr = criaGrafoCSR(G, ordemG);
+    if (!gravaGrafoCSR(csr, nomeArquivo))
+        printf("Nao foi possivel gravar %s\n", nomeArquivo);
+    liberaGrafoCSR(csr);
+
+    csr = carregaGrafoCSR(nomeArquivo);
+    if (csr == NULL)
+        printf("Nao foi possivel carregar %s\n", nomeArquivo);
+    else
     {
-        printf("Fila atingiu sua capacidade máxima: %d", fila->tamanhoMax);
-        return;
+        largura = criaResultadoBuscaLargura(csr->ordem);
+        profundidade = criaResultadoBuscaProfundidade(csr->ordem);
+        buscaLarguraCSR(csr, 0, largura);
+        buscaProfundidaCSR(csr, profundidade);
+
+        imprimeGrafoCSR(csr, profundidade->componente);
+        imprimeBuscaLargura(largura);
+        imprimeBuscaProfundidade(profundidade);
+
+        liberaResultadoBuscaLargura(largura);
+        liberaResultadoBuscaProfundidade(profundidade);
+        liberaGrafoCSR(csr);
     }
 
-    fila->valores[fila->indiceInsercao] = elemento;
-    fila->indiceInsercao++;
+    remove(nomeArquivo);
+    liberaGrafo(G);
 }
 
-int desinfileira(Fila *fila)
+/**
+ * Le o grafo de testeGrafoNaoConexo de um arquivo texto de arestas
+ * (formato SNAP), com 2 threads.
+ * Grafo nao conexo
+*/
+void testeArquivoTexto()
 {
-    int elementoRetirado;
+    GrafoCSR *csr;
+    ResultadoBuscaProfundidade *profundidade;
+    FILE *arquivo;
+    const char *nomeArquivo = "grafo-teste.txt";
 
-    /*validando se estamos desinfileirando antes do elemento ser inserido*/
-    if (fila->indiceInsercao < fila->indiceRetirada)
+    arquivo = fopen(nomeArquivo, "w");
+    if (arquivo == NULL)
     {
-        printf("Fazendo retirada da fila antes de adicionar elemento. %d - %d", fila->indiceInsercao, fila->indiceRetirada);
-        return ELEMENTO_NAO_DEFINIDO;
+        printf("Nao foi possivel gravar %s\n", nomeArquivo);
+        return;
     }
+    fprintf(arquivo, "# Grafo nao conexo\n# v1 v2\n0 1\n1 2\n2\t3\n\n4 4\n");
+    fclose(arquivo);
 
-    elementoRetirado = fila->valores[fila->indiceRetirada];
-    fila->indiceRetirada++;
+    csr = carregaArestasTexto(nomeArquivo, 2);
+    remove(nomeArquivo);
+    if (csr == NULL)
+    {
+        printf("Nao foi possivel carregar %s\n", nomeArquivo);
+        return;
+    }
 
-    return elementoRetirado;
+    profundidade = criaResultadoBuscaProfundidade(csr->ordem);
+    buscaProfundidaCSR(csr, profundidade);
+    imprimeGrafoCSR(csr, profundidade->componente);
+
+    liberaResultadoBuscaProfundidade(profundidade);
+    liberaGrafoCSR(csr);
 }
 
 /**
- * Funcao de utilidade para checar se a fila 
- * passada como parametro esta vazia ou nao.
- * No algoritmo de busca em profundida, 
- * usada como condicao de parada
+ * Geradores de grafos sinteticos: imprime a ordem, o tamanho e o numero
+ * de componentes de cada grafo gerado. A grade tambem e gravada em
+ * arquivo e lida de volta, devendo resultar no mesmo grafo
 */
-bool filaEstaVazia(Fila *fila)
+void testeGeradores()
 {
-    return fila->indiceRetirada >= fila->indiceInsercao;
+    GrafoCSR *csr;
+    int *arestas, *componente;
+    const char *nomes[4] = {"R-MAT", "Erdos-Renyi", "Grade", "Caminho"};
+    const char *nomeArquivo = "grafo-gerado.txt";
+    int ordens[4] = {1 << 8, 256, 16 * 16, 1000};
+    int numArestas, i;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (i == 0)
+            arestas = geraArestasRMAT(8, 8, 1, 4, &numArestas);
+        else if (i == 1)
+            arestas = geraArestasErdosRenyi(256, 256, 1, 4, &numArestas);
+        else if (i == 2)
+            arestas = geraArestasGrade(16, 16, 4, &numArestas);
+        else
+            arestas = geraArestasCaminho(1000, 4, &numArestas);
+
+        csr = criaGrafoCSRArestas(ordens[i], arestas, numArestas);
+        componente = (int *)malloc(sizeof(int) * csr->ordem);
+        definirComponentesParaleloCSR(csr, componente, 4);
+        printf("%-12s ordem: %4d  tamanho: %5d  componentes: %d\n", nomes[i], csr->ordem,
+               calculaTamanhoCSR(csr), numComponentes(componente, csr->ordem));
+
+        if (i == 2 && gravaArestasTexto(arestas, numArestas, nomeArquivo))
+        {
+            liberaGrafoCSR(csr);
+            csr = carregaArestasTexto(nomeArquivo, 4);
+            remove(nomeArquivo);
+            printf("%-12s ordem: %4d  tamanho: %5d  (lida de %s)\n", nomes[i], csr->ordem,
+                   calculaTamanhoCSR(csr), nomeArquivo);
+        }
+
+        free(componente);
+        free(arestas);
+        liberaGrafoCSR(csr);
+    }
+    printf("\n");
 }
 
 /**
- * Funcao de utilidade para a liberação dos elementos da fila da memoria
+ * Busca em largura a partir de todos os vertices de uma grade lado x lado
+ * de uma so vez. A excentricidade dos cantos e 2 * (lado - 1), e a
+ * do centro (lado impar) e lado - 1
 */
-void liberaFila(Fila *fila)
+void testeBuscaLarguraMultipla(int lado)
 {
-    free(fila->valores);
-    free(fila);
-}
+    GrafoCSR *csr;
+    ResultadoBuscaMultipla *resultado;
+    int *arestas, *fontes;
+    int numArestas, ordemG, i, v;
 
-void buscaLargura(Vertice G[], int ordem, int verticeInicial)
-{
-    Fila *Q;
-    Aresta *aux;
+    arestas = geraArestasGrade(lado, lado, 1, &numArestas);
+    ordemG = lado * lado;
+    csr = criaGrafoCSRArestas(ordemG, arestas, numArestas);
 
-    /*inicializacao do algoritmo:
-    todos os vertices brancos, distancia inicial inicializada e pai como nulo*/
+    fontes = (int *)malloc(sizeof(int) * ordemG);
+    for (i = 0; i < ordemG; i++)
+        fontes[i] = i;
 
-    int i;
-    for (i = 0; i < ordem; i++)
+    resultado = criaResultadoBuscaMultipla(ordemG, ordemG, true);
+    buscaLarguraMultiplaCSR(csr, fontes, ordemG, 2, resultado);
+
+    printf("==Busca em Largura com %d fontes==:\n", ordemG);
+    for (i = 0; i < ordemG; i++)
     {
-        G[i].corBuscaLargura = BRANCO;
-        G[i].distanciaBuscaLargura = INT_MAX;
-        G[i].paiBuscaLargura = ELEMENTO_NAO_DEFINIDO;
+        printf("V%d (excentricidade: %d) (soma das distancias: %lu):", i,
+               resultado->excentricidade[i], resultado->somaDistancias[i]);
+        for (v = 0; v < ordemG; v++)
+            printf("%2d", resultado->distancia[(size_t)i * ordemG + v]);
+        printf("\n");
     }
+    printf("=========================:\n\n");
 
-    /*
-    verticie inicial:
-    cor cinza, distancia zero (por ser ele mesmo) 
-    e sem pais na arvore de busca*/
-    G[verticeInicial].corBuscaLargura = CINZA;
-    G[verticeInicial].distanciaBuscaLargura = 0;
-    G[verticeInicial].paiBuscaLargura = ELEMENTO_NAO_DEFINIDO;
+    liberaResultadoBuscaMultipla(resultado);
+    free(fontes);
+    liberaGrafoCSR(csr);
+    free(arestas);
+}
 
-    Q = inicializaFila(ordem); /*Fila vazia, para ser usar, no maximo, ordem vezes*/
-    enfileira(Q, verticeInicial);
+/**
+ * Diametro de um caminho (ordem - 1), de uma grade (soma dos lados - 2)
+ * e de um grafo R-MAT, com o numero de buscas usadas, e excentricidades
+ * de um caminho de 7 vertices: 6 5 4 3 4 5 6
+*/
+void testeDiametro()
+{
+    GrafoCSR *csr;
+    int *arestas;
+    int excentricidade[7];
+    int numArestas, diametro, superior, i;
+    const char *nomes[3] = {"Caminho", "Grade", "R-MAT"};
 
-    while (!filaEstaVazia(Q))
+    printf("==Diametro==:\n");
+    for (i = 0; i < 3; i++)
     {
-        int indiceVerticeAtual = desinfileira(Q);
-        Vertice *u = &G[indiceVerticeAtual];
+        if (i == 0)
+            arestas = geraArestasCaminho(1000, 1, &numArestas);
+        else if (i == 1)
+            arestas = geraArestasGrade(30, 40, 1, &numArestas);
+        else
+            arestas = geraArestasRMAT(10, 4, 1, 1, &numArestas);
+        csr = criaGrafoCSRArestas(i == 0 ? 1000 : i == 1 ? 1200 : 1024, arestas, numArestas);
 
-        /*Iterando sobre as arestas do vertice atual, e fazendo a busca por eles*/
-        for (aux = u->prim; aux != NULL; aux = aux->prox)
-        {
-            Vertice *v = &G[aux->nome];
-            if (v->corBuscaLargura == BRANCO)
-            {
-                v->corBuscaLargura = CINZA;
-                v->distanciaBuscaLargura = u->distanciaBuscaLargura + 1;
-                v->paiBuscaLargura = u->nome;
+        diametro = calculaDiametroCSR(csr, 0, &superior);
+        printf("%-8s diametro: %d\n", nomes[i], diametro);
 
-                enfileira(Q, v->nome);
-            }
-        }
+        diametro = calculaDiametroCSR(csr, 2, &superior);
+        printf("%-8s com 2 buscas: entre %d e %d\n", nomes[i], diametro, superior);
 
-        /*busca completamente realizada a partir do vertice atual
-        pintando ele de preto para indicar isso*/
-        u->corBuscaLargura = PRETO;
+        liberaGrafoCSR(csr);
+        free(arestas);
     }
 
-    liberaFila(Q);
+    arestas = geraArestasCaminho(7, 1, &numArestas);
+    csr = criaGrafoCSRArestas(7, arestas, numArestas);
+    calculaExcentricidadesCSR(csr, excentricidade, NULL, 0);
+    printf("Excentricidades do caminho:");
+    for (i = 0; i < 7; i++)
+        printf(" %d", excentricidade[i]);
+    printf("\n=========================:\n\n");
+
+    liberaGrafoCSR(csr);
+    free(arestas);
 }
 
 /**
- * A gente vai dizer que um grafo e conexo a partir da
- * realizacao da busca em profundida se todos os vertices
- * do grafo estiverem pintados de preto
- * 
- * O metodo atual conta a quantidade de vertices de cada cor,
- * imprime o resultado e retorna verdadeiro se, e apenas se, 
- * todos os vertices forem pretos
+ * Oraculo de distancias em uma grade 10 x 10 com 4 referencias (os
+ * vertices de maior grau). A distancia entre dois vertices da grade e a
+ * soma das diferencas de linha e coluna
 */
-bool eConexoBLargura(Vertice G[], int ordem)
+void testeOraculoDistancias()
 {
-    int pretos, i;
-    pretos = 0;
+    GrafoCSR *csr;
+    OraculoDistancias *oraculo;
+    int *arestas;
+    int pares[] = {0, 99, 0, 9, 11, 88, 45, 54, 23, 23};
+    int numArestas, i, inferior, superior;
 
-    /*Contando quantos vertices pretos tem no grafo*/
-    for (i = 0; i < ordem; i++)
-        if (G[i].corBuscaLargura == PRETO)
-            pretos++;
+    arestas = geraArestasGrade(10, 10, 1, &numArestas);
+    csr = criaGrafoCSRArestas(100, arestas, numArestas);
+    oraculo = criaOraculoDistancias(csr, 4, REFERENCIAS_POR_GRAU, 0, 1);
+
+    printf("==Oraculo de Distancias==:\n");
+    printf("Referencias:");
+    for (i = 0; i < oraculo->numReferencias; i++)
+        printf(" V%d", oraculo->referencias[i]);
+    printf("\n");
+
+    for (i = 0; i < 5; i++)
+    {
+        superior = estimaDistanciaOraculo(oraculo, pares[2 * i], pares[2 * i + 1], &inferior);
+        printf("V%d - V%d: entre %d e %d, exata: %d\n", pares[2 * i], pares[2 * i + 1], inferior, superior,
+               distanciaExataOraculo(oraculo, pares[2 * i], pares[2 * i + 1]));
+    }
+    printf("=========================:\n\n");
 
-    return pretos == ordem;
+    liberaOraculoDistancias(oraculo);
+    liberaGrafoCSR(csr);
+    free(arestas);
 }
 
 /**
- * Aqui, para conseguirmos definir a partir do presente
- * algoritmo se um grafo e conexo ou nao, precisamos 
- * passar para a funcao de visita o componente
+ * Caminho minimo entre cantos opostos de uma grade 5 x 5 (8 arestas)
+ * e entre vertices sem caminho no grafo de testeGrafoNaoConexo
 */
-void buscaProfundida(Vertice G[], int ordem)
+void testeBuscaLarguraBidirecional()
 {
-    int tempo;
-    int i, j;
+    GrafoCSR *csr;
+    BuscaBidirecional *busca;
+    int *arestas;
+    int arestasNaoConexo[] = {0, 1, 1, 2, 2, 3};
+    int caminho[25];
+    int numArestas, distancia, i;
 
-    /*Inicializacao de valores dos vertices para a realizacao do algoritmo*/
-    for (i = 0; i < ordem; i++)
-    {
-        G[i].corBuscaProfundida = BRANCO;
-        G[i].paiBuscaProfundida = ELEMENTO_NAO_DEFINIDO;
-    }
+    printf("==Busca em Largura Bidirecional==:\n");
+    arestas = geraArestasGrade(5, 5, 1, &numArestas);
+    csr = criaGrafoCSRArestas(25, arestas, numArestas);
+    busca = criaBuscaBidirecional(csr);
 
-    /*tempo: variavel informativa, para determinar em que momentos os vertices foram explorados*/
-    tempo = 0;
-    for (j = 0; j < ordem; j++)
-    {
-        if (G[j].corBuscaProfundida == BRANCO)
-            /*Somente o indice 0 vai ser usado se o grafo for conexo*/
-            buscaProfundidaVisita(G, ordem, j, &tempo, j);
-    }
+    distancia = buscaLarguraBidirecionalCSR(busca, 0, 24, INT_MAX, caminho);
+    printf("V0 - V24: distancia %d, caminho:", distancia);
+    for (i = 0; i <= distancia; i++)
+        printf(" V%d", caminho[i]);
+    printf("\n");
+    printf("V0 - V24 com no maximo 7 arestas: %s\n",
+           buscaLarguraBidirecionalCSR(busca, 0, 24, 7, NULL) == INT_MAX ? "sem caminho" : "com caminho");
+
+    liberaBuscaBidirecional(busca);
+    liberaGrafoCSR(csr);
+    free(arestas);
+
+    csr = criaGrafoCSRArestas(5, arestasNaoConexo, 3);
+    busca = criaBuscaBidirecional(csr);
+    printf("V0 - V3: %d, V0 - V4: %s\n", buscaLarguraBidirecionalCSR(busca, 0, 3, INT_MAX, NULL),
+           buscaLarguraBidirecionalCSR(busca, 0, 4, INT_MAX, NULL) == INT_MAX ? "inalcancavel" : "alcancavel");
+    printf("=========================:\n\n");
+
+    liberaBuscaBidirecional(busca);
+    liberaGrafoCSR(csr);
 }
 
 /**
- * Função recursiva, usada para navegar entre os vértices do grafo
- * Recebe como parametro um ponteiro de tempo, que vai ser usado para
- * documentar o momento em que o vertice foi 'descoberto' e 'finalizado'.
- * Recebe tambem a componente do vertice sendo visitado. Isso nos permite, 
- * a partir da funcao base de buscaProfundida, decidir se o grafo e conexo 
- * ou nao
+ * Dois triangulos ligados por uma ponte, com um vertice pendurado
+ * no segundo e uma aresta dupla (pontes: V2-V3 e V5-V6)
 */
-void buscaProfundidaVisita(Vertice G[], int ordem, int verticeAtual, int *tempo, int componente)
+void testeBiconexas()
 {
-    Aresta *aux;
-    Vertice *u;
+    int arestas[] = {0, 1, 1, 2, 2, 0, 2, 3, 3, 4, 4, 5, 5, 3, 5, 6, 7, 8, 7, 8};
+    GrafoCSR *csr = criaGrafoCSRArestas(9, arestas, 10);
+    ResultadoBiconexas *biconexas = criaResultadoBiconexas(9);
 
-    (*tempo)++;
+    printf("==Componentes Biconexas==:\n");
+    componentesBiconexasCSR(csr, biconexas);
+    imprimeBiconexas(biconexas);
+    printf("V4-V5 na componente %d, V7-V8 %s ponte\n", componenteBiconexaAresta(biconexas, 4, 5),
+           ePonte(biconexas, 7, 8) ? "e" : "nao e");
+    printf("=========================:\n\n");
 
-    /*Comeco da visita de um vertice: documentar o tempo de inicio e pintar ele de cinza*/
-    u = &G[verticeAtual];
-    u->tempoDescobertaBuscaProf = *tempo;
-    u->corBuscaProfundida = CINZA;
-    u->componente = componente; /*usado na verificacao de conexidade*/
+    liberaResultadoBiconexas(biconexas);
+    liberaGrafoCSR(csr);
+}
 
-    /*Prestar uma visita a todos os vertices adjances do vertice atual.
-    Considerar que o metodo atual e recursivo, e sendo esse o caso, a finalizacao
-    se da uma vez que todos os vertices chamados abaixo ja tiverem passado pelo mesmo processo*/
-    for (aux = u->prim; aux != NULL; aux = aux->prox)
-    {
+/**
+ * Construcao paralela de um grafo com arestas repetidas e lacos,
+ * mantendo tudo e depois descartando repetidas e lacos
+*/
+void testeConstrucaoParalela()
+{
+    int arestas[] = {0, 1, 1, 0, 0, 1, 2, 2, 1, 2, 3, 3, 2, 3, 3, 2};
+    GrafoCSR *csr;
 
-        Vertice *v = &G[aux->nome];
-        if (v->corBuscaProfundida == BRANCO) /*Apenas visitando vertices brancos, evitando repeticoes*/
-        {
-            v->paiBuscaProfundida = u->nome; /*Criacao de arvore de busca*/
-            buscaProfundidaVisita(G, ordem, v->nome, tempo, componente);
-        }
-    }
+    printf("==Construcao Paralela do Grafo CSR==:\n");
+    csr = criaGrafoCSRParalelo(4, arestas, 8, CONSTRUCAO_ORDENADA, 2);
+    printf("Com repetidas e lacos:\n");
+    imprimeGrafoCSR(csr, NULL);
+    liberaGrafoCSR(csr);
 
-    /*Depois de iterar sobre todos os vertices adjancetes do 
-    vertice atual, temos o tempo de finalizacao: pintamos o 
-    vertice de preto, ele esta finalizado*/
-    (*tempo)++;
-    u->corBuscaProfundida = PRETO;
-    u->tempoFinalizacaoBuscaProf = *tempo;
+    csr = criaGrafoCSRParalelo(4, arestas, 8, CONSTRUCAO_SEM_REPETIDAS | CONSTRUCAO_SEM_LACOS, 2);
+    printf("Sem repetidas e lacos:\n");
+    imprimeGrafoCSR(csr, NULL);
+    liberaGrafoCSR(csr);
 }
 
 /**
- * Funcao de utilidade usada para definir se um grafo e conexo
- * ou nao a partir da buscaProfundida
- * 
- * A presente funcao conta quantos componentes estao definidos no 
- * grafo a partir do atributo 'componente' marcados nos vertices.
+ * Reordenacao de um caminho com os vertices embaralhados, e busca em
+ * largura sobre o grafo reordenado com o resultado nos nomes originais
 */
-int numComponentes(Vertice G[], int ordem)
+void testeReordenacao()
 {
-    int *componentesDefinidos;
-    int encontrados;
-    int i, j;
-    bool jaDefinido;
+    int arestas[] = {3, 7, 7, 0, 0, 5, 5, 2, 2, 6, 6, 1, 1, 4};
+    const char *nomes[] = {"RCM", "Grau", "Largura"};
+    int metodos[] = {REORDENACAO_RCM, REORDENACAO_GRAU, REORDENACAO_LARGURA};
+    GrafoCSR *csr, *reordenado;
+    Reordenacao *reordenacao;
+    ResultadoBuscaLargura *largura;
+    int i, v;
 
-    componentesDefinidos = (int *)malloc(ordem * sizeof(int));
-    encontrados = 0;
+    printf("==Reordenacao dos Vertices==:\n");
+    csr = criaGrafoCSRArestas(8, arestas, 7);
+    largura = criaResultadoBuscaLargura(8);
 
-    for (i = 0; i < ordem; i++)
+    for (i = 0; i < 3; i++)
     {
+        reordenacao = calculaReordenacaoCSR(csr, metodos[i]);
+        printf("%s, novos nomes:", nomes[i]);
+        for (v = 0; v < 8; v++)
+            printf(" V%d->%d", v, reordenacao->novoNome[v]);
+        printf("\n");
 
-        int componenteAtual = G[i].componente;
-        if (componenteAtual == ELEMENTO_NAO_DEFINIDO)
-        {
-            /*Executar definirComponentesGrafo(G[], int)*/
-            /*Componente não definido encontrado, nao incluso na contagem*/
-            continue;
-        }
-
-        jaDefinido = false;
-
-        for (j = 0; j < encontrados; j++)
+        if (metodos[i] == REORDENACAO_RCM)
         {
-            if (componenteAtual == componentesDefinidos[j])
-                jaDefinido = true; /*Componente ja contabilizado, nao incluindo*/
+            reordenado = reordenaGrafoCSR(csr, reordenacao, 2);
+            imprimeGrafoCSR(reordenado, NULL);
+            buscaLarguraCSR(reordenado, reordenacao->novoNome[3], largura);
+            traduzResultadoBuscaLargura(reordenacao, largura);
+            imprimeBuscaLargura(largura);
+            liberaGrafoCSR(reordenado);
         }
-
-        if (!jaDefinido)
-            componentesDefinidos[encontrados++] = componenteAtual;
+        liberaReordenacao(reordenacao);
     }
+    printf("=========================:\n\n");
 
-    free(componentesDefinidos);
-    return encontrados;
+    liberaResultadoBuscaLargura(largura);
+    liberaGrafoCSR(csr);
 }
 
-bool eConexoBProf(Vertice G[], int ordem)
+/**
+ * Compressao de um grafo R-MAT pequeno: memoria das duas formas, e
+ * comparacao das buscas e componentes com as do grafo CSR ordenado
+*/
+void testeGrafoComprimido()
 {
-    /*
-    Definição de grafo conexo: se para todo o par de 
-    vertices, existe um caminho entre eles, e temos 
-    pelo menos um vértice. Ou seja, se temos uma, e somente,
-    uma componente definida nele. 
+    GrafoCSR *csr;
+    GrafoComprimido *comprimido;
+    ResultadoBuscaLargura *larguraCSR, *larguraComprimido;
+    ResultadoBuscaProfundidade *profundidadeCSR, *profundidadeComprimido;
+    int *arestas, *componente;
+    int numArestas, ordemG;
+    bool iguais;
 
-    Importante: grafos vazios não são conexos.
-    */
+    printf("==Grafo Comprimido==:\n");
+    arestas = geraArestasRMAT(10, 8, 7, 1, &numArestas);
+    ordemG = 1 << 10;
+    csr = criaGrafoCSRParalelo(ordemG, arestas, numArestas, CONSTRUCAO_ORDENADA, 1);
+    comprimido = comprimeGrafoCSR(csr, 2);
+    printf("Semi-arestas: %d, CSR: %lu bytes, comprimido: %lu bytes\n", csr->numSemiArestas,
+           (unsigned long)(sizeof(int) * (ordemG + 1 + csr->numSemiArestas)),
+           (unsigned long)memoriaGrafoComprimido(comprimido));
 
-    return numComponentes(G, ordem) == 1;
-}
+    larguraCSR = criaResultadoBuscaLargura(ordemG);
+    larguraComprimido = criaResultadoBuscaLargura(ordemG);
+    buscaLarguraCSR(csr, 0, larguraCSR);
+    buscaLarguraComprimido(comprimido, 0, larguraComprimido);
+    iguais = memcmp(larguraCSR->pai, larguraComprimido->pai, sizeof(int) * ordemG) == 0;
+    printf("Busca em largura igual a do CSR: %s\n", iguais ? "sim" : "nao");
 
-/**
- * Nao cria o grafo. Funcao a ser executada por todos os testes:
- * Realiza a busca em profundidade e em largura, verifica a conexidade
- * usando ambos os metodos e entao imprime o resultado
- * 
-*/
-void testeGrafo(Vertice *G, int ordem, int verticeInicialBuscaLarg)
-{
-    buscaLargura(G, ordem, verticeInicialBuscaLarg);
-    buscaProfundida(G, ordem);
+    profundidadeCSR = criaResultadoBuscaProfundidade(ordemG);
+    profundidadeComprimido = criaResultadoBuscaProfundidade(ordemG);
+    buscaProfundidaCSR(csr, profundidadeCSR);
+    buscaProfundidaComprimido(comprimido, profundidadeComprimido);
+    iguais = memcmp(profundidadeCSR->tempoFinalizacao, profundidadeComprimido->tempoFinalizacao, sizeof(int) * ordemG) == 0;
+    printf("Busca em profundidade igual a do CSR: %s\n", iguais ? "sim" : "nao");
 
-    imprimeGrafo(G, ordem);
-    imprimeBuscaLargura(G, ordem);
-    imprimeBuscaProfundidade(G, ordem);
+    componente = (int *)malloc(sizeof(int) * ordemG);
+    definirComponentesComprimido(comprimido, componente, 2);
+    iguais = memcmp(componente, profundidadeCSR->componente, sizeof(int) * ordemG) == 0;
+    printf("Componentes: %d, iguais as da busca em profundidade: %s\n", numComponentes(componente, ordemG),
+           iguais ? "sim" : "nao");
+    printf("=========================:\n\n");
 
-    printf("\n");
+    free(componente);
+    free(arestas);
+    liberaResultadoBuscaLargura(larguraCSR);
+    liberaResultadoBuscaLargura(larguraComprimido);
+    liberaResultadoBuscaProfundidade(profundidadeCSR);
+    liberaResultadoBuscaProfundidade(profundidadeComprimido);
+    liberaGrafoComprimido(comprimido);
+    liberaGrafoCSR(csr);
 }
 
-void testeGrafoNaoConexo()
+/**
+ * Mesmo grafo de testeGrafoCompletoExcetoPorUmVertice como matriz de bits,
+ * e a escolha automatica da representacao para um grafo esparso e um denso
+*/
+void testeGrafoDenso(int ordemG, int verticeIsolado)
 {
     Vertice *G;
-    int ordemG = 5;
+    GrafoDenso *denso;
+    GrafoAutomatico *grafo;
+    ResultadoBuscaLargura *largura;
+    int *arestas, *componente;
+    int i, j, numArestas;
 
+    printf("==Grafo Denso (Matriz de Bits)==:\n");
     criaGrafo(&G, ordemG);
-    acrescentaAresta(G, ordemG, 0, 1);
-    acrescentaAresta(G, ordemG, 1, 2);
-    acrescentaAresta(G, ordemG, 2, 3);
+    for (i = 0; i < ordemG; i++)
+        for (j = i + 1; j < ordemG; j++)
+            if (i != verticeIsolado && j != verticeIsolado)
+                acrescentaAresta(G, ordemG, i, j);
 
-    testeGrafo(G, ordemG, 0);
+    denso = criaGrafoDenso(G, ordemG);
+    printf("Tamanho: listas %d, matriz %d\n", calculaTamanho(G, ordemG), calculaTamanhoDenso(denso));
+    largura = criaResultadoBuscaLargura(ordemG);
+    buscaLarguraDenso(denso, 0, largura);
+    imprimeBuscaLargura(largura);
+    liberaResultadoBuscaLargura(largura);
+    liberaGrafoDenso(denso);
+    liberaGrafo(G);
+
+    /*Grafo esparso (grade) e denso (metade das arestas possiveis) de mesma ordem*/
+    componente = (int *)malloc(sizeof(int) * 256);
+    arestas = geraArestasGrade(16, 16, 1, &numArestas);
+    grafo = criaGrafoAutomatico(256, arestas, numArestas, 2);
+    definirComponentesAutomatico(grafo, componente, 2);
+    printf("Grade 16 x 16: %s, tamanho %d, componentes %d\n", grafo->denso != NULL ? "matriz" : "CSR",
+           calculaTamanhoAutomatico(grafo), numComponentes(componente, 256));
+    liberaGrafoAutomatico(grafo);
+    free(arestas);
+
+    arestas = geraArestasErdosRenyi(256, 256 * 255 / 4, 3, 1, &numArestas);
+    grafo = criaGrafoAutomatico(256, arestas, numArestas, 2);
+    definirComponentesAutomatico(grafo, componente, 2);
+    printf("Erdos-Renyi com %d arestas: %s, tamanho %d, componentes %d\n", numArestas,
+           grafo->denso != NULL ? "matriz" : "CSR", calculaTamanhoAutomatico(grafo), numComponentes(componente, 256));
+    printf("=========================:\n\n");
+    liberaGrafoAutomatico(grafo);
+    free(arestas);
+    free(componente);
 }
 
-void testeGrafoConexo()
+/**
+ * Grafo dinamico: um ciclo 0-1-2-3 ligado ao caminho 4-5-6. Remover uma
+ * aresta do ciclo nao muda as componentes (ha substituta); remover a
+ * ponte 3-4 separa o caminho. Depois, um lote religa tudo
+*/
+void testeRemocaoArestas()
 {
     Vertice *G;
-    int ordemG = 3;
+    int ordemG = 8;
+    AtualizacaoAresta lote[] = {{ATUALIZACAO_REMOVE, 5, 6},
+                                {ATUALIZACAO_ACRESCENTA, 6, 7},
+                                {ATUALIZACAO_ACRESCENTA, 2, 5},
+                                {ATUALIZACAO_REMOVE, 0, 7}};
 
+    printf("==Remocao de Arestas==:\n");
     criaGrafo(&G, ordemG);
     acrescentaAresta(G, ordemG, 0, 1);
     acrescentaAresta(G, ordemG, 1, 2);
+    acrescentaAresta(G, ordemG, 2, 3);
+    acrescentaAresta(G, ordemG, 3, 0);
+    acrescentaAresta(G, ordemG, 3, 4);
+    acrescentaAresta(G, ordemG, 4, 5);
+    acrescentaAresta(G, ordemG, 5, 6);
+    printf("Componentes: %d\n", numComponentesConjuntos(G));
 
-    testeGrafo(G, ordemG, 0);
+    removeAresta(G, ordemG, 0, 1);
+    printf("Sem 0-1: %d componentes, V0 e V1 %s\n", numComponentesConjuntos(G),
+           mesmaComponente(G, ordemG, 0, 1) ? "juntos" : "separados");
+    removeAresta(G, ordemG, 3, 4);
+    printf("Sem 3-4: %d componentes, V0 e V6 %s\n", numComponentesConjuntos(G),
+           mesmaComponente(G, ordemG, 0, 6) ? "juntos" : "separados");
+
+    printf("Lote: %d de 4 atualizacoes aplicadas\n", aplicaAtualizacoes(G, ordemG, lote, 4));
+    definirComponentesConjuntos(G, ordemG);
+    imprimeGrafo(G, ordemG);
+    liberaGrafo(G);
 }
 
 /**
- * Grafo simples e completo: todos os vertices 
- * adjacentes a todos os os outros vertices, sem laços 
- * 
- * Grafo conexo
+ * Graus e tamanho mantidos pelo grafo: uma estrela com centro em 0,
+ * um laco em 5 (conta duas vezes no grau) e uma aresta removida
 */
-void testeGrafoCompleto(int ordemG)
+void testeDistribuicaoGraus()
 {
     Vertice *G;
-    int i, j;
+    const int *grau;
+    int *histograma;
+    int ordemG = 7, grauMaximo, i;
 
+    printf("==Distribuicao dos Graus==:\n");
     criaGrafo(&G, ordemG);
+    for (i = 1; i <= 5; i++)
+        acrescentaAresta(G, ordemG, 0, i);
+    acrescentaAresta(G, ordemG, 5, 5);
+    removeAresta(G, ordemG, 0, 4);
 
+    grau = grausGrafo(G);
+    histograma = distribuicaoGraus(G, ordemG, &grauMaximo);
+    printf("Tamanho: %d\nGraus:", calculaTamanho(G, ordemG));
     for (i = 0; i < ordemG; i++)
-        for (j = i + 1; j < ordemG; j++) /*+1: evitando lacos*/
-            acrescentaAresta(G, ordemG, i, j);
+        printf(" V%d:%d", i, grau[i]);
+    printf("\nHistograma:");
+    for (i = 0; i <= grauMaximo; i++)
+        printf(" %d:%d", i, histograma[i]);
+    printf("\n=========================:\n\n");
 
-    testeGrafo(G, ordemG, 0);
+    free(histograma);
+    liberaGrafo(G);
 }
 
+#ifdef INSTRUMENTACAO
 /**
- * Grafo simples e completo, com excecao de um vertice, que esta isolado
- * Grafo nao conexo
+ * Contadores das buscas sobre uma grade de lado x lado: o numero de
+ * vertices de cada nivel da busca em largura cresce ate a diagonal e
+ * depois diminui. Com CONTADORES_HARDWARE, mede tambem o hardware
 */
-void testeGrafoCompletoExcetoPorUmVertice(int ordemG, int verticeIsolado)
+void testeInstrumentacao(int lado)
 {
-    Vertice *G;
-    int i, j;
+    GrafoCSR *csr;
+    ResultadoBuscaLargura *largura;
+    ResultadoBuscaProfundidade *profundidade;
+    int *arestas;
+    int numArestas;
+#ifdef CONTADORES_HARDWARE
+    ContadoresHardware hardware;
+    bool comHardware = abreContadoresHardware(&hardware);
+#endif
 
-    /*Validacao do indice do vertice isolado*/
-    if (verticeIsolado >= ordemG)
-    {
-        printf("Vertice isolado nao presente entre os vertices do grafo");
-        return;
-    }
+    arestas = geraArestasGrade(lado, lado, 1, &numArestas);
+    csr = criaGrafoCSRArestas(lado * lado, arestas, numArestas);
+    largura = criaResultadoBuscaLargura(csr->ordem);
+    profundidade = criaResultadoBuscaProfundidade(csr->ordem);
 
-    criaGrafo(&G, ordemG);
+    printf("====Contadores da Busca em Largura====:\n");
+#ifdef CONTADORES_HARDWARE
+    if (comHardware)
+        comecaContadoresHardware(&hardware);
+#endif
+    buscaLarguraCSR(csr, 0, largura);
+#ifdef CONTADORES_HARDWARE
+    if (comHardware)
+        terminaContadoresHardware(&hardware);
+#endif
+    imprimeContadoresBusca();
+#ifdef CONTADORES_HARDWARE
+    if (comHardware)
+        imprimeContadoresHardware(&hardware);
+    else
+        printf("Contadores de hardware indisponiveis\n");
+#endif
 
-    for (i = 0; i < ordemG; i++)
-    {
-        if (i == verticeIsolado) continue; /*pulando vertice isolado*/
-        for (j = i + 1; j < ordemG; j++) /*+1: evitando lacos*/
-        {
-            if (j == verticeIsolado) continue; /*pulando vertice isolado*/
-            acrescentaAresta(G, ordemG, i, j);
-        }
-    }
+    printf("==Contadores da Busca em Profundidade==:\n");
+    buscaProfundidaCSR(csr, profundidade);
+    imprimeContadoresBusca();
+    printf("\n");
 
-    testeGrafo(G, ordemG, 0);
+#ifdef CONTADORES_HARDWARE
+    fechaContadoresHardware(&hardware);
+#endif
+    liberaResultadoBuscaLargura(largura);
+    liberaResultadoBuscaProfundidade(profundidade);
+    liberaGrafoCSR(csr);
+    free(arestas);
 }
+#endif
 
+/* SEM_MAIN: permite incluir este arquivo em outro programa, como src/benchmark.c */
+#ifndef SEM_MAIN
 int main(int argc, char *argv[])
 {
     testeGrafoNaoConexo();
     testeGrafoConexo();
     testeGrafoCompleto(10);
     testeGrafoCompletoExcetoPorUmVertice(10, 5);
+    testeGrafoCSR();
+    testeBuscaLarguraHibrida(10);
+    testeBuscaLarguraParalela(3);
+    testeArquivoGrafo();
+    testeArquivoTexto();
+    testeGeradores();
+    testeBuscaLarguraMultipla(3);
+    testeDiametro();
+    testeOraculoDistancias();
+    testeBuscaLarguraBidirecional();
+    testeBiconexas();
+    testeConstrucaoParalela();
+    testeReordenacao();
+    testeGrafoComprimido();
+    testeGrafoDenso(10, 5);
+    testeRemocaoArestas();
+    testeDistribuicaoGraus();
+#ifdef INSTRUMENTACAO
+    testeInstrumentacao(4);
+#endif
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
+#endif